@@ -45,6 +45,8 @@ void Internal::learn_unit_clause (int lit) {
       proof->add_derived_unit_clause (id, lit);
   }
   mark_fixed (lit);
+  if (sharer)
+    export_shared_unit (lit);
 }
 
 /*------------------------------------------------------------------------*/
@@ -282,7 +284,7 @@ inline void Internal::analyze_literal (int lit, int &open,
 
   assert (val (lit) < 0);
   assert (v.level <= level);
-  assert (v.reason != external_reason);
+  assert (v.level < level || v.reason != external_reason);
   if (v.level < level)
     clause.push_back (lit);
   Level &l = control[v.level];
@@ -977,7 +979,7 @@ void Internal::analyze () {
   //
   if (!level) {
     learn_empty_clause ();
-    if (external->learner)
+    if (external->exporting ())
       external->export_learned_empty_clause ();
     // lrat_chain.clear (); done in learn_empty_clause
     STOP (analyze);
@@ -1125,9 +1127,9 @@ void Internal::analyze () {
     if (opts.bump)
       bump_variables ();
 
-    if (external->learner)
-      external->export_learned_large_clause (clause);
-  } else if (external->learner)
+    if (external->exporting ())
+      external->export_learned_large_clause (clause, glue);
+  } else if (external->exporting ())
     external->export_learned_unit_clause (-uip);
 
   // Update actual size statistics.
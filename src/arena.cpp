@@ -7,24 +7,57 @@ Arena::Arena (Internal *i) {
   internal = i;
 }
 
+void Arena::release (Space &space) {
+  if (space.huge)
+    deallocate_huge_pages (space.start, space.end - space.start);
+  else
+    delete[] space.start;
+  space.start = space.top = space.end = 0;
+  space.huge = false;
+}
+
 Arena::~Arena () {
-  delete[] from.start;
-  delete[] to.start;
+  release (old);
+  release (young);
+  release (to);
 }
 
+// Huge pages only pay off for spaces spanning several of them (2 MB on
+// x86), so spaces smaller than 'arenahugemin' megabytes are allocated on
+// the heap as before.
+
 void Arena::prepare (size_t bytes) {
   LOG ("preparing 'to' space of arena with %zd bytes", bytes);
   assert (!to.start);
-  to.top = to.start = new char[bytes];
+  const size_t min_bytes = (size_t) internal->opts.arenahugemin << 20;
+  if (internal->opts.arenahuge && bytes >= min_bytes)
+    to.start = allocate_huge_pages (bytes);
+  to.huge = (to.start != 0);
+  if (!to.huge)
+    to.start = new char[bytes];
+  to.top = to.start;
   to.end = to.start + bytes;
 }
 
 void Arena::swap () {
-  delete[] from.start;
-  LOG ("delete 'from' space of arena with %zd bytes",
-       (size_t) (from.end - from.start));
-  from = to;
+  LOG ("delete 'old' space of arena with %zd bytes",
+       (size_t) (old.end - old.start));
+  release (old);
+  LOG ("delete 'young' space of arena with %zd bytes",
+       (size_t) (young.end - young.start));
+  release (young);
+  old = to;
+  to.start = to.top = to.end = 0;
+  to.huge = false;
+}
+
+void Arena::swap_young () {
+  LOG ("delete 'young' space of arena with %zd bytes",
+       (size_t) (young.end - young.start));
+  release (young);
+  young = to;
   to.start = to.top = to.end = 0;
+  to.huge = false;
 }
 
 } // namespace CaDiCaL
@@ -50,6 +50,16 @@ namespace CaDiCaL {
 //   ...
 //
 // One has to be really careful with 'qi' references to arena memory.
+//
+// The arena is generational.  The 'swap' above turns the 'to' space into
+// the 'old' space, which holds all clauses surviving a major collection.
+// Clauses learned after that are allocated outside of the arena and moved
+// during the following minor collections into the 'young' space with
+// 'swap_young' instead, which keeps the 'old' space untouched.  Thus only
+// young clauses need to be copied and have their references fixed.
+// Garbage clauses in the 'old' space just waste memory until the next
+// major collection, which is scheduled in 'copy_non_garbage_clauses' if
+// this waste becomes too large (see 'opts.arenaold').
 
 struct Internal;
 
@@ -57,9 +67,12 @@ class Arena {
 
   Internal *internal;
 
-  struct {
+  struct Space {
     char *start, *top, *end;
-  } from, to;
+    bool huge; // allocated with 'allocate_huge_pages'
+  } old, young, to;
+
+  void release (Space &);
 
 public:
   Arena (Internal *);
@@ -67,22 +80,59 @@ public:
 
   // Prepare 'to' space to hold that amount of memory.  Precondition is that
   // the 'to' space is empty.  The following sequence of 'copy' operations
-  // can use as much memory in sum as pre-allocated here.
+  // can use as much memory in sum as pre-allocated here.  Large spaces are
+  // backed by huge pages if 'opts.arenahuge' is set.
   //
   void prepare (size_t bytes);
 
   // Does the memory pointed to by 'p' belong to this arena? More precisely
-  // to the 'from' space, since that is the only one remaining after 'swap'.
+  // to the 'old' or 'young' space, since these are the only ones remaining
+  // after 'swap' or 'swap_young'.
   //
   bool contains (void *p) const {
     char *c = (char *) p;
-    return from.start <= c && c < from.top;
+    return (old.start <= c && c < old.top) ||
+           (young.start <= c && c < young.top);
+  }
+
+  // Does the memory pointed to by 'p' belong to the 'old' space?
+  //
+  bool contains_old (void *p) const {
+    char *c = (char *) p;
+    return old.start <= c && c < old.top;
+  }
+
+  // Position of the memory pointed to by 'p' in the 'old' space followed
+  // by the 'young' space.  It only depends on the order of allocation and
+  // not on where these spaces are located.  Memory outside of the arena
+  // is positioned after both spaces.
+  //
+  size_t position (void *p) const {
+    char *c = (char *) p;
+    if (old.start <= c && c < old.top)
+      return c - old.start;
+    const size_t res = old_bytes ();
+    if (young.start <= c && c < young.top)
+      return res + (c - young.start);
+    return res + young_bytes ();
+  }
+
+  // Allocated bytes in the 'old' and 'young' space.
+  //
+  size_t old_bytes () const { return old.top - old.start; }
+  size_t young_bytes () const { return young.top - young.start; }
+
+  // Bytes of the 'old' and 'young' space backed by huge pages.
+  //
+  size_t huge_bytes () const {
+    return (old.huge ? old.end - old.start : 0) +
+           (young.huge ? young.end - young.start : 0);
   }
 
   // Allocate that amount of memory in 'to' space.  This assumes the 'to'
   // space has been prepared to hold enough memory with 'prepare'.  Then
   // copy the memory pointed to by 'p' of size 'bytes'.  Note that it does
-  // not matter whether 'p' is in 'from' or allocated outside of the arena.
+  // not matter whether 'p' is in the arena or allocated outside of it.
   //
   char *copy (const char *p, size_t bytes) {
     char *res = to.top;
@@ -92,11 +142,17 @@ public:
     return res;
   }
 
-  // Completely delete 'from' space and then replace 'from' by 'to' (by
-  // pointer swapping).  Everything previously allocated (in 'from') and not
-  // explicitly copied to 'to' with 'copy' becomes invalid.
+  // Completely delete 'old' and 'young' space and then replace 'old' by
+  // 'to' (by pointer swapping).  Everything previously allocated (in 'old'
+  // or 'young') and not explicitly copied to 'to' with 'copy' becomes
+  // invalid.  This is the end of a major collection.
   //
   void swap ();
+
+  // Same for a minor collection, which only deletes the 'young' space and
+  // replaces it by 'to'.  The 'old' space remains valid.
+  //
+  void swap_young ();
 };
 
 } // namespace CaDiCaL
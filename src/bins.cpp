@@ -19,4 +19,61 @@ void Internal::reset_bins () {
   LOG ("reset binary implication graph");
 }
 
+/*------------------------------------------------------------------------*/
+
+// The snapshot is only rebuilt if binary clauses were deleted or clauses
+// were moved since it was built, or to merge added edges.  Clauses are
+// traversed backward, such that edges are in the same order as watches.
+
+void Internal::update_bin_graph () {
+  BinGraph &g = bin_graph;
+  if (g.valid && g.added.empty ())
+    return;
+  stats.bingraphs++;
+  const size_t size = 2 * vsize;
+  g.offsets.assign (size + 1, 0);
+  for (const auto &c : clauses) {
+    if (c->garbage || c->size != 2)
+      continue;
+    g.offsets[vlit (c->literals[0])]++;
+    g.offsets[vlit (c->literals[1])]++;
+  }
+  unsigned sum = 0;
+  for (size_t i = 0; i < size; i++) {
+    sum += g.offsets[i];
+    g.offsets[i] = sum;
+  }
+  g.offsets[size] = sum;
+  g.edges.resize (sum);
+  const auto begin = clauses.begin ();
+  auto i = clauses.end ();
+  while (i != begin) {
+    Clause *c = *--i;
+    if (c->garbage || c->size != 2)
+      continue;
+    const int lit = c->literals[0], other = c->literals[1];
+    g.edges[--g.offsets[vlit (lit)]] = BinEdge{other, c};
+    g.edges[--g.offsets[vlit (other)]] = BinEdge{lit, c};
+  }
+  erase_vector (g.heads);
+  erase_vector (g.added);
+  g.valid = true;
+  LOG ("built binary implication graph with %u edges", sum);
+}
+
+void Internal::add_bin_graph_edges (Clause *c) {
+  assert (c->size == 2);
+  BinGraph &g = bin_graph;
+  if (!g.valid)
+    return;
+  if (g.heads.empty ())
+    g.heads.resize (2 * vsize, 0);
+  for (int i = 0; i < 2; i++) {
+    const int lit = c->literals[i], other = c->literals[!i];
+    unsigned &head = g.heads[vlit (lit)];
+    g.added.push_back (BinLink{BinEdge{other, c}, head});
+    head = g.added.size ();
+  }
+}
+
 } // namespace CaDiCaL
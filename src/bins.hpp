@@ -17,6 +17,46 @@ typedef vector<Bin> Bins;
 inline void shrink_bins (Bins &bs) { shrink_vector (bs); }
 inline void erase_bins (Bins &bs) { erase_vector (bs); }
 
+/*------------------------------------------------------------------------*/
+
+// Compressed sparse row snapshot of the binary implication graph used by
+// probing, decomposition and transitive reduction, which then stream over
+// contiguous edges instead of filtering binary clauses out of watch lists.
+// The edges of the binary clauses with literal 'lit' (thus implied by the
+// negation of 'lit') are 'edges[offsets[vlit (lit)]..offsets[vlit (lit)+1]]'.
+// Binary clauses added after building the snapshot, e.g., hyper binary
+// resolvents during probing, are linked in 'added' starting at 'heads'.
+// Like watch lists the snapshot might still contain garbage clauses, but
+// it is invalidated when binary clauses are deleted (see 'bins.cpp').
+
+struct Clause;
+
+struct BinEdge {
+  int lit;        // other literal
+  Clause *clause; // binary clause
+};
+
+struct BinLink {
+  BinEdge edge;
+  unsigned next; // index plus one of next added edge ('0' = none)
+};
+
+struct BinEdges {
+  const BinEdge *first, *last;
+  const BinEdge *begin () const { return first; }
+  const BinEdge *end () const { return last; }
+  size_t size () const { return last - first; }
+};
+
+struct BinGraph {
+  bool valid;
+  vector<unsigned> offsets; // by 'vlit' plus sentinel
+  vector<BinEdge> edges;
+  vector<unsigned> heads; // of added edges by 'vlit' ('0' = none)
+  vector<BinLink> added;
+  BinGraph () : valid (false) {}
+};
+
 } // namespace CaDiCaL
 
 #endif
@@ -25,6 +25,10 @@ class App : public Handler, public Terminator {
 
   Solver *solver; // Global solver.
 
+  // Parallel portfolio wrapped around 'solver' for '--threads <n>'.
+  //
+  PortfolioSolver *portfolio;
+
 #ifndef __WIN32
   // Command line options.
   //
@@ -144,6 +148,10 @@ void App::print_usage (bool all) {
         "  -d <limit>     limit the number of decisions (default "
         "unlimited)\n"
         "\n"
+        "  --threads <n>  solve with a portfolio of '<n>' threads "
+        "(default '1')\n"
+        "  --conquer <d>  cube-and-conquer with cubes of depth '<d>'\n"
+        "\n"
         "  -o <output>    write simplified CNF in DIMACS format to file\n"
         "  -e <extend>    write reconstruction/extension stack to file\n"
 #ifdef LOGGING
@@ -266,8 +274,10 @@ void App::print_witness (FILE *file) {
       fputc ('v', file), c = 1;
     if (i++ == max_var)
       tmp = 0;
-    else
-      tmp = solver->val (i) < 0 ? -i : i;
+    else {
+      const int val = portfolio ? portfolio->val (i) : solver->val (i);
+      tmp = val < 0 ? -i : i;
+    }
     char str[32];
     snprintf (str, sizeof str, " %d", tmp);
     int l = strlen (str);
@@ -371,10 +381,13 @@ int App::main (int argc, char **argv) {
   bool proof_specified = false, dimacs_specified = false;
   int optimize = 0, preprocessing = 0, localsearch = 0;
   const char *output_path = 0, *extension_path = 0;
-  int conflict_limit = -1, decision_limit = -1;
+  int conflict_limit = -1, decision_limit = -1, threads = 1;
+  int conquer = -1;
   const char *conflict_limit_specified = 0;
   const char *decision_limit_specified = 0;
   const char *localsearch_specified = 0;
+  const char *threads_specified = 0;
+  const char *conquer_specified = 0;
 #ifndef __MINGW32__
   const char *time_limit_specified = 0;
 #endif
@@ -480,6 +493,30 @@ int App::main (int argc, char **argv) {
         APPERR ("invalid decision limit");
       else
         decision_limit_specified = argv[i];
+    } else if (!strcmp (argv[i], "--threads")) {
+      if (++i == argc)
+        APPERR ("argument to '--threads' missing");
+      else if (threads_specified)
+        APPERR ("multiple thread options '--threads %s' and '--threads %s'",
+                threads_specified, argv[i]);
+      else if (!parse_int_str (argv[i], threads))
+        APPERR ("invalid argument in '--threads %s'", argv[i]);
+      else if (threads < 1)
+        APPERR ("invalid number of threads");
+      else
+        threads_specified = argv[i];
+    } else if (!strcmp (argv[i], "--conquer")) {
+      if (++i == argc)
+        APPERR ("argument to '--conquer' missing");
+      else if (conquer_specified)
+        APPERR ("multiple cube depths '--conquer %s' and '--conquer %s'",
+                conquer_specified, argv[i]);
+      else if (!parse_int_str (argv[i], conquer))
+        APPERR ("invalid argument in '--conquer %s'", argv[i]);
+      else if (conquer < 0)
+        APPERR ("invalid cube depth");
+      else
+        conquer_specified = argv[i];
     }
 #ifndef __WIN32
     else if (!strcmp (argv[i], "-t")) {
@@ -710,6 +747,18 @@ int App::main (int argc, char **argv) {
   }
   solver->options ();
 
+  if (threads > 1 || conquer_specified) {
+    solver->section ("portfolio");
+    if (threads > 1)
+      solver->message ("solving with %d threads (due to '--threads %s')",
+                       threads, threads_specified);
+    if (conquer_specified)
+      solver->message ("cube-and-conquer with depth %d "
+                       "(due to '--conquer %s')",
+                       conquer, conquer_specified);
+    portfolio = new PortfolioSolver (solver, threads);
+  }
+
   int res = 0;
 
   if (incremental) {
@@ -762,7 +811,7 @@ int App::main (int argc, char **argv) {
           time.start = absolute_process_time ();
         }
 #endif
-        res = solver->solve ();
+        res = portfolio ? portfolio->solve () : solver->solve ();
 #ifndef QUIET
         if (!quiet) {
           time.delta = absolute_process_time () - time.start;
@@ -806,7 +855,8 @@ int App::main (int argc, char **argv) {
         } else if (res == 20) {
           unsatisfiable++;
           for (auto other : cube)
-            if (solver->failed (other))
+            if (portfolio ? portfolio->failed (other)
+                          : solver->failed (other))
               failed.push_back (other);
           for (auto other : failed)
             solver->add (-other);
@@ -835,7 +885,10 @@ int App::main (int argc, char **argv) {
       res = 0;
   } else {
     solver->section ("solving");
-    res = solver->solve ();
+    if (conquer_specified)
+      res = portfolio->cube_and_conquer (conquer);
+    else
+      res = portfolio ? portfolio->solve () : solver->solve ();
   }
 
   if (proof_specified) {
@@ -925,17 +978,19 @@ void App::init () {
 
   CaDiCaL::Options::reportdefault = 1;
   solver = new Solver ();
+  portfolio = 0;
   Signal::set (this);
 }
 
 /*------------------------------------------------------------------------*/
 
-App::App () : solver (0) {} // Only partially initialize the app.
+App::App () : solver (0), portfolio (0) {} // Only partially initialize.
 
 App::~App () {
   if (!solver)
     return; // Only partially initialized.
   Signal::reset ();
+  delete portfolio;
   delete solver;
 }
 
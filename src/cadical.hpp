@@ -193,10 +193,12 @@ struct External;
 // Forward declaration of call-back classes. See bottom of this file.
 
 class Learner;
+class BatchLearner;
 class Terminator;
 class ClauseIterator;
 class WitnessIterator;
 class ExternalPropagator;
+struct Portfolio;
 
 /*------------------------------------------------------------------------*/
 
@@ -324,6 +326,33 @@ public:
   void connect_learner (Learner *learner);
   void disconnect_learner ();
 
+  // Add call-back which receives learned clauses as a whole together with
+  // their glue (see 'BatchLearner' below).  It is independent of the
+  // learner connected with 'connect_learner' and both can be connected at
+  // the same time.  Disconnecting delivers clauses still buffered.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_batch_learner (BatchLearner *learner);
+  void disconnect_batch_learner ();
+
+  // Import a redundant clause given as span of 'size' external literals
+  // (without terminating zero) together with its glue, e.g., a clause
+  // learned by another solver on the same formula.  The clause has to be
+  // implied by the formula but is not checked and is trusted in proofs
+  // (traced as original clause).  It is only queued and then attached at
+  // the next restart as reducible learned clause, unless it contains a
+  // variable which is unknown, eliminated or substituted, in which case
+  // it is silently dropped.  As the call only copies the literals, it can
+  // also be made during solving from call-backs on the solver thread, such
+  // as 'Terminator::terminate' or 'Learner::learn'.
+  //
+  //   require (VALID_OR_SOLVING)
+  //   ensure (VALID_OR_SOLVING)
+  //
+  void import_redundant_clause (const int *lits, size_t size, int glue);
+
   // ====== END IPASIR =====================================================
 
   // ====== BEGIN IPASIR-UP ================================================
@@ -616,6 +645,16 @@ public:
   int64_t redundant () const;   // Number of active redundant clauses.
   int64_t irredundant () const; // Number of active irredundant clauses.
 
+  // Some statistics counters can be queried by name, currently 'conflicts',
+  // 'decisions', 'propagations' (during search), 'exported' and 'imported'
+  // (shared clauses), as well as 'unexplained' (external propagations not
+  // explained due to 'explainbound').  Unknown names yield '-1'.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  int64_t get_statistic_value (const char *name) const;
+
   //------------------------------------------------------------------------
   // This function executes the given number of preprocessing rounds. It is
   // similar to 'solve' with 'limits ("preprocessing", rounds)' except that
@@ -890,6 +929,7 @@ private:
   friend class App;
   friend class Mobical;
   friend class Parser;
+  friend class PortfolioSolver;
 
   // Read solution in competition format for debugging and testing.
   //
@@ -1007,6 +1047,28 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Connected batch learners receive each exported learned clause with a
+// single call to 'learn' as a span of 'size' external literals (without
+// terminating zero) together with its glue (which is zero for units and
+// the empty clause) and whether it is a unit.  The span is only valid
+// during the call.  Again 'learning' can filter clauses before they are
+// externalized.  If the option 'learnbatch' is non-zero, the solver buffers
+// learned clauses and delivers them every 'learnbatch' conflicts as well
+// as at the end of 'solve' and then calls 'flush' after the last clause of
+// such a batch.  Without buffering 'flush' is never called.
+
+class BatchLearner {
+public:
+  virtual ~BatchLearner () {}
+  virtual bool learning (int size, int glue) {
+    (void) size, (void) glue;
+    return true;
+  }
+  virtual void learn (const int *lits, size_t size, int glue,
+                      bool unit) = 0;
+  virtual void flush () {}
+};
+
 /*------------------------------------------------------------------------*/
 
 // Allows to connect an external propagator to propagate values to variables
@@ -1016,8 +1078,9 @@ public:
 class ExternalPropagator {
 
 public:
-  // This flag is currently checked only when the propagator is connected.
-  bool is_lazy = false; // lazy propagator only checks complete assignments
+  // These flags are currently checked only when the propagator is connected.
+  bool is_lazy = false;    // lazy propagator only checks complete assignments
+  bool is_batched = false; // use the span based functions below
 
   virtual ~ExternalPropagator () {}
 
@@ -1082,6 +1145,42 @@ public:
   // The actual function called to add the external clause.
   //
   virtual int cb_add_external_clause_lit () = 0;
+
+  // Batched interface.  If 'is_batched' is set, the solver calls the
+  // following functions instead of their literal-by-literal counterparts
+  // above, which saves one virtual call per literal.  Assignments are
+  // collected and notified in one call per propagation round (fixed
+  // assignments are notified separately with 'is_fixed' set).  Reason and
+  // external clauses are returned as a span of 'size' literals without
+  // terminating zero, which only needs to stay valid until the next call to
+  // any function of the propagator.  The default implementations fall back
+  // to the literal-by-literal functions.
+  //
+  virtual void notify_assignments (const int *lits, size_t size,
+                                   bool is_fixed) {
+    for (size_t i = 0; i < size; i++)
+      notify_assignment (lits[i], is_fixed);
+  }
+
+  virtual size_t cb_add_reason_clause (int propagated_lit,
+                                       const int *&lits) {
+    batched_clause.clear ();
+    while (int lit = cb_add_reason_clause_lit (propagated_lit))
+      batched_clause.push_back (lit);
+    lits = batched_clause.data ();
+    return batched_clause.size ();
+  }
+
+  virtual size_t cb_add_external_clause (const int *&lits) {
+    batched_clause.clear ();
+    while (int lit = cb_add_external_clause_lit ())
+      batched_clause.push_back (lit);
+    lits = batched_clause.data ();
+    return batched_clause.size ();
+  }
+
+protected:
+  std::vector<int> batched_clause; // for the default implementations
 };
 
 /*------------------------------------------------------------------------*/
@@ -1125,6 +1224,72 @@ public:
 
 /*------------------------------------------------------------------------*/
 
+// Parallel portfolio solving on top of 'Solver::copy'.  Before each
+// 'solve' call the primary solver is copied into 'threads - 1' clones,
+// which are diversified through different seeds, initial phases and
+// configurations.  The clones run in their own threads while the primary
+// solver runs in the calling thread, thus connected terminators and
+// learners of the primary solver are only called from the calling thread.
+// Learned units and short clauses with small glue are shared between all
+// workers.  The first worker finding a result terminates all others.
+//
+// Clauses, assumptions, constraints, frozen variables and options are all
+// given to the primary solver which is owned by the user and can be used
+// incrementally as before.  It keeps the (redundant) shared clauses it
+// imported, while the clones are deleted at the next 'solve' call or on
+// destruction.  After 'solve' returned '10' or '20' the model or the
+// failed assumptions of the winning worker are available through 'val'
+// and 'failed' until the next 'solve' call.  If the primary solver traces
+// a proof or has an external propagator connected, then only the primary
+// solver is used.  The same applies if threads are not supported.
+
+class PortfolioSolver {
+
+  Solver *primary;
+  int threads;
+  Portfolio *portfolio;
+
+  int workers ();      // number of workers actually used
+  int run (int);       // run workers in parallel
+
+public:
+  PortfolioSolver (Solver *primary, int threads);
+  ~PortfolioSolver ();
+
+  //   require (READY)
+  //   ensure (UNKNOWN | SATISFIED | UNSATISFIED)  of the winner
+  //
+  int solve ();
+
+  // Cube-and-conquer: split the formula with 'generate_cubes' up to the
+  // given depth on the primary solver and then solve the cubes as
+  // assumptions on all workers, which take the next unsolved cube as soon
+  // they become idle.  The failed assumptions of refuted cubes are shared
+  // and used to skip cubes containing them.  Requires that there are no
+  // assumptions nor constraints.  If all cubes are refuted '20' is
+  // returned and 'winner' is zero.
+  //
+  //   require (READY)
+  //   ensure (UNKNOWN | SATISFIED | UNSATISFIED)  of the winner
+  //
+  int cube_and_conquer (int depth);
+
+  // Model and failed assumptions of the winning worker.
+  //
+  int val (int lit);
+  bool failed (int lit);
+
+  // The solver which produced the last result (zero before).
+  //
+  Solver *winner ();
+
+  // Asynchronously terminate all workers (thread-safe).
+  //
+  void terminate ();
+};
+
+/*------------------------------------------------------------------------*/
+
 } // namespace CaDiCaL
 
 #endif
@@ -73,7 +73,10 @@ void Internal::mark_added (Clause *c) {
 
 /*------------------------------------------------------------------------*/
 
-Clause *Internal::new_clause (bool red, int glue) {
+// A fresh clause identifier is allocated unless 'id' was already used to
+// trace the clause in the proof (as for original or imported clauses).
+
+Clause *Internal::new_clause (bool red, int glue, uint64_t id) {
 
   assert (clause.size () <= (size_t) INT_MAX);
   const int size = (int) clause.size ();
@@ -96,7 +99,8 @@ Clause *Internal::new_clause (bool red, int glue) {
   Clause *c = (Clause *) new char[bytes];
 
   stats.added.total++;
-  c->id = ++clause_id;
+  assert (id <= clause_id);
+  c->id = id ? id : ++clause_id;
 
   c->conditioned = false;
   c->covered = false;
@@ -143,6 +147,9 @@ Clause *Internal::new_clause (bool red, int glue) {
   clauses.push_back (c);
   LOG (c, "new pointer %p", (void *) c);
 
+  if (size == 2)
+    add_bin_graph_edges (c);
+
   if (likely_to_be_kept_clause (c))
     mark_added (c);
 
@@ -218,6 +225,9 @@ size_t Internal::shrink_clause (Clause *c, int new_size) {
   if (likely_to_be_kept_clause (c))
     mark_added (c);
 
+  if (new_size == 2)
+    add_bin_graph_edges (c);
+
   return res;
 }
 
@@ -305,6 +315,9 @@ void Internal::mark_garbage (Clause *c) {
   c->garbage = true;
   c->used = 0;
 
+  if (c->size == 2)
+    bin_graph.valid = false;
+
   LOG (c, "marked garbage pointer %p", (void *) c);
 }
 
@@ -514,9 +527,7 @@ void Internal::add_new_original_clause (uint64_t id) {
 #endif
       int glue = (int) (learned_levels.size () + unassigned);
       assert (glue <= (int) clause.size ());
-      Clause *c = new_clause (false, glue);
-      c->id = new_id;
-      clause_id--;
+      Clause *c = new_clause (false, glue, new_id);
       watch_clause (c);
       clause.clear ();
       original.clear ();
@@ -550,6 +561,8 @@ Clause *Internal::new_learned_redundant_clause (int glue) {
   }
   assert (watching ());
   watch_clause (res);
+  if (sharer)
+    export_shared_clause (glue);
   return res;
 }
 
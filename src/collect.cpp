@@ -135,6 +135,8 @@ void Internal::protect_reasons () {
       Clause *reason = v.reason;
       if (!reason)
         continue;
+      if (reason == external_reason)
+        continue;
       LOG (reason, "protecting assigned %d reason %p", lit,
            (void *) reason);
       assert (!reason->reason);
@@ -194,6 +196,8 @@ void Internal::unprotect_reasons () {
       Clause *reason = v.reason;
       if (!reason)
         continue;
+      if (reason == external_reason)
+        continue;
       LOG (reason, "unprotecting assigned %d reason %p", lit,
            (void *) reason);
       assert (reason->reason);
@@ -297,9 +301,10 @@ void Internal::update_reason_references () {
       continue;
     if (c == external_reason)
       continue;
-    LOG (c, "updating assigned %d reason", lit);
     assert (c->reason);
-    assert (c->moved);
+    if (!c->moved)
+      continue;
+    LOG (c, "updating assigned %d reason", lit);
     Clause *d = c->copy;
     v.reason = d;
 #ifdef LOGGING
@@ -320,9 +325,12 @@ void Internal::update_reason_references () {
       Clause *c = v.reason;
       if (!c)
         continue;
-      LOG (c, "updating assigned %d reason", lit);
+      if (c == external_reason)
+        continue;
       assert (c->reason);
-      assert (c->moved);
+      if (!c->moved)
+        continue;
+      LOG (c, "updating assigned %d reason", lit);
       Clause *d = c->copy;
       v.reason = d;
 #ifdef LOGGING
@@ -371,6 +379,26 @@ void Internal::delete_garbage_clauses () {
 
 /*------------------------------------------------------------------------*/
 
+// Binary clauses are never dereferenced during propagation (see the
+// discussion in 'propagate') and thus do not benefit from being placed
+// close to the other clauses watched by the same literal.  Unless they
+// already reside in the arena (for instance after being shrunken) or
+// 'opts.arenabinary' is set, binary clauses allocated outside of the arena
+// are kept where they are.  This saves copying them, fixing their watches
+// and the 'to' space needed for them, which on instances with many binary
+// clauses is a substantial part of the moving garbage collector.
+
+// During minor collections (see 'arena.hpp') clauses in the 'old' space of
+// the arena are kept where they are too.
+
+inline bool Internal::moving_clause (Clause *c, bool major) {
+  if (!major && arena.contains_old (c))
+    return false;
+  if (c->size > 2 || opts.arenabinary)
+    return true;
+  return arena.contains (c);
+}
+
 // This is the start of the copying garbage collector using the arena.  At
 // the core is the following function, which copies a clause to the 'to'
 // space of the arena.  Be careful if this clause is a reason of an
@@ -387,23 +415,70 @@ void Internal::copy_clause (Clause *c) {
        (void *) c->copy);
 }
 
+// Sorting clauses by their address would make the order of clauses and
+// thus the search depend on where the spaces of the arena and the clauses
+// kept outside of the arena are allocated.  Instead clauses in the arena
+// are ranked by their position in the 'old' and then the 'young' space,
+// followed by all other clauses ranked by their identifier.
+
+struct clause_arena_rank {
+  Internal *internal;
+  clause_arena_rank (Internal *i) : internal (i) {}
+  typedef uint64_t Type;
+  Type operator() (Clause *c) const {
+    const Arena &arena = internal->arena;
+    const uint64_t bytes = arena.old_bytes () + arena.young_bytes ();
+    const uint64_t res = arena.position (c);
+    if (res < bytes)
+      return res;
+    return bytes + (uint64_t) c->id;
+  }
+};
+
 // This is the moving garbage collector.
 
 void Internal::copy_non_garbage_clauses () {
 
   size_t collected_clauses = 0, collected_bytes = 0;
   size_t moved_clauses = 0, moved_bytes = 0;
+  size_t old_bytes = 0, young_bytes = 0;
 
-  // First determine 'moved_bytes' and 'collected_bytes'.
+  // First determine 'collected_bytes' and how many bytes of live clauses
+  // are in the 'old' space and would have to be moved otherwise.
   //
   for (const auto &c : clauses)
-    if (!c->collect ())
-      moved_bytes += c->bytes (), moved_clauses++;
-    else
+    if (c->collect ())
       collected_bytes += c->bytes (), collected_clauses++;
+    else if (arena.contains_old (c))
+      old_bytes += c->bytes ();
+    else if (moving_clause (c, true))
+      young_bytes += c->bytes ();
+
+  // A minor collection only evacuates young clauses and keeps the 'old'
+  // space as it is.  We fall back to a major collection if the 'old' space
+  // contains too much garbage (including garbage left over from previous
+  // minor collections and bytes lost by shrinking clauses) or the young
+  // clauses outgrow the old ones.
+  //
+  const size_t old_space = arena.old_bytes ();
+  const size_t wasted = old_space - old_bytes;
+  bool major = !opts.arenagen || !old_space || young_bytes > old_bytes ||
+               wasted > old_space / 100.0 * opts.arenaold;
+  if (major) {
+    moved_bytes = old_bytes + young_bytes;
+    stats.arena.major++;
+  } else {
+    moved_bytes = young_bytes;
+    stats.arena.minor++;
+  }
+  stats.arena.moved += moved_bytes;
+  for (const auto &c : clauses)
+    if (!c->collect () && moving_clause (c, major))
+      moved_clauses++;
 
   PHASE ("collect", stats.collections,
-         "moving %zd bytes %.0f%% of %zd non garbage clauses", moved_bytes,
+         "%s collection moving %zd bytes %.0f%% of %zd non garbage clauses",
+         major ? "major" : "minor", moved_bytes,
          percent (moved_bytes, collected_bytes + moved_bytes),
          moved_clauses);
   (void) moved_clauses, (void) collected_clauses, (void) collected_bytes;
@@ -415,7 +490,7 @@ void Internal::copy_non_garbage_clauses () {
   //
   if (opts.arenacompact)
     for (const auto &c : clauses)
-      if (!c->collect () && arena.contains (c))
+      if (!c->collect () && arena.contains (c) && moving_clause (c, major))
         copy_clause (c);
 
   if (opts.arenatype == 1 || !watching ()) {
@@ -434,7 +509,7 @@ void Internal::copy_non_garbage_clauses () {
     // benefit due to better cache locality.
 
     for (const auto &c : clauses)
-      if (!c->moved && !c->collect ())
+      if (!c->moved && !c->collect () && moving_clause (c, major))
         copy_clause (c);
 
   } else if (opts.arenatype == 2) {
@@ -447,7 +522,8 @@ void Internal::copy_non_garbage_clauses () {
     for (int sign = -1; sign <= 1; sign += 2)
       for (auto idx : vars)
         for (const auto &w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
+          if (!w.clause->moved && !w.clause->collect () &&
+              moving_clause (w.clause, major))
             copy_clause (w.clause);
 
   } else {
@@ -463,7 +539,8 @@ void Internal::copy_non_garbage_clauses () {
     for (int sign = -1; sign <= 1; sign += 2)
       for (int idx = queue.last; idx; idx = link (idx).prev)
         for (const auto &w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
+          if (!w.clause->moved && !w.clause->collect () &&
+              moving_clause (w.clause, major))
             copy_clause (w.clause);
   }
 
@@ -471,7 +548,7 @@ void Internal::copy_non_garbage_clauses () {
   // a rare situation, and now is only left as defensive code.
   //
   for (const auto &c : clauses)
-    if (!c->collect () && !c->moved)
+    if (!c->collect () && !c->moved && moving_clause (c, major))
       copy_clause (c);
 
   flush_all_occs_and_watches ();
@@ -485,19 +562,24 @@ void Internal::copy_non_garbage_clauses () {
     Clause *c = *i;
     if (c->collect ())
       delete_clause (c);
+    else if (c->moved)
+      *j++ = c->copy, deallocate_clause (c);
     else
-      assert (c->moved), *j++ = c->copy, deallocate_clause (c);
+      assert (!moving_clause (c, major)), *j++ = c;
   }
   clauses.resize (j - clauses.begin ());
   if (clauses.size () < clauses.capacity () / 2)
     shrink_vector (clauses);
 
-  if (opts.arenasort)
-    rsort (clauses.begin (), clauses.end (), pointer_rank ());
-
-  // Release 'from' space completely and then swap 'to' with 'from'.
+  // Release the evacuated spaces completely and then replace them by 'to'.
   //
-  arena.swap ();
+  if (major)
+    arena.swap ();
+  else
+    arena.swap_young ();
+
+  if (opts.arenasort)
+    rsort (clauses.begin (), clauses.end (), clause_arena_rank (this));
 
   PHASE ("collect", stats.collections,
          "collected %zd bytes %.0f%% of %zd garbage clauses",
@@ -544,6 +626,7 @@ void Internal::garbage_collection () {
   START (collect);
   report ('G', 1);
   stats.collections++;
+  bin_graph.valid = false; // clauses are moved or deleted
   mark_satisfied_clauses_as_garbage ();
   if (!protected_reasons)
     protect_reasons ();
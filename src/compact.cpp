@@ -178,6 +178,7 @@ void Internal::compact () {
   assert (propagated == trail.size ());
 
   garbage_collection ();
+  assert (!bin_graph.valid);
 
   Mapper mapper (this);
 
@@ -410,15 +411,16 @@ void Internal::compact () {
   // Special case for 'val' as for 'val' we trade branch less code for
   // memory and always allocated an [-maxvar,...,maxvar] array.
   {
-    signed char *new_vals = new signed char[2 * mapper.new_vsize];
+    signed char *new_vals = new signed char[2 * mapper.new_vsize + 3];
     ignore_clang_analyze_memory_leak_warning = new_vals;
-    new_vals += mapper.new_vsize;
+    memset (new_vals, 0, 3); // padding (see 'enlarge_vals')
+    new_vals += mapper.new_vsize + 3;
     for (auto src : vars)
       new_vals[-mapper.map_idx (src)] = vals[-src];
     for (auto src : vars)
       new_vals[mapper.map_idx (src)] = vals[src];
     new_vals[0] = 0;
-    vals -= vsize;
+    vals -= vsize + 3;
     delete[] vals;
     vals = new_vals;
   }
@@ -145,6 +145,7 @@ bool Internal::decompose_round () {
   START_SIMPLIFIER (decompose, DECOMP);
 
   stats.decompositions++;
+  update_bin_graph ();
 
   const size_t size_dfs = 2 * (1 + (size_t) max_var);
   DFS *dfs = new DFS[size_dfs];
@@ -195,9 +196,9 @@ bool Internal::decompose_round () {
           assert (!reprs[vlit (parent)]);
 
           // Go over all implied literals, thus need to iterate over all
-          // binary watched clauses with the negation of 'parent'.
+          // binary clauses with the negation of 'parent'.
 
-          Watches &ws = watches (-parent);
+          const BinEdges edges = bin_edges (-parent);
 
           // Two cases: Either the node has never been visited before, i.e.,
           // it's depth first search index is zero, then perform the
@@ -215,10 +216,8 @@ bool Internal::decompose_round () {
 
             unsigned new_min = parent_dfs.min;
 
-            for (const auto &w : ws) {
-              if (!w.binary ())
-                continue;
-              const int child = w.blit;
+            for (const auto &e : edges) {
+              const int child = e.lit;
               if (!active (child))
                 continue;
               DFS &child_dfs = dfs[vlit (child)];
@@ -268,11 +267,8 @@ bool Internal::decompose_round () {
                 while (!todo.empty ()) {
                   const int next = todo.back ();
                   todo.pop_back ();
-                  Watches &next_ws = watches (-next);
-                  for (const auto &w : next_ws) {
-                    if (!w.binary ())
-                      continue;
-                    const int child = w.blit;
+                  for (const auto &e : bin_edges (-next)) {
+                    const int child = e.lit;
                     if (!active (child))
                       continue;
                     if (!flags (child).seen)
@@ -280,7 +276,7 @@ bool Internal::decompose_round () {
                     DFS &child_dfs = dfs[vlit (child)];
                     if (child_dfs.parent)
                       continue;
-                    child_dfs.parent = w.clause;
+                    child_dfs.parent = e.clause;
                     todo.push_back (child);
                   }
                 }
@@ -385,10 +381,8 @@ bool Internal::decompose_round () {
             // Now traverse all the children in the binary implication
             // graph but keep 'parent' on the stack for 'post-fix' work.
 
-            for (const auto &w : ws) {
-              if (!w.binary ())
-                continue;
-              const int child = w.blit;
+            for (const auto &e : edges) {
+              const int child = e.lit;
               if (!active (child))
                 continue;
               DFS &child_dfs = dfs[vlit (child)];
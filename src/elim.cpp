@@ -1,5 +1,11 @@
 #include "internal.hpp"
 
+#include <atomic>
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
@@ -658,9 +664,19 @@ void Internal::mark_eliminated_clauses_as_garbage (Eliminator &eliminator,
 
 void Internal::try_to_eliminate_variable (Eliminator &eliminator,
                                           int pivot) {
+  pivot = prepare_to_eliminate_variable (pivot);
+  if (pivot)
+    eliminate_prepared_variable (eliminator, pivot);
+}
+
+// Flush garbage clauses from the occurrence lists of 'pivot', sort them
+// and return 'pivot' in the phase with fewer occurrences, or zero if it
+// should not be tried to be eliminated.
+
+int Internal::prepare_to_eliminate_variable (int pivot) {
 
   if (!active (pivot))
-    return;
+    return 0;
   assert (!frozen (pivot));
 
   // First flush garbage clauses.
@@ -675,13 +691,11 @@ void Internal::try_to_eliminate_variable (Eliminator &eliminator,
   LOG ("pivot %d occurs positively %" PRId64
        " times and negatively %" PRId64 " times",
        pivot, pos, neg);
-  assert (!eliminator.schedule.contains (abs (pivot)));
   assert (pos <= neg);
 
   if (pos && neg > opts.elimocclim) {
     LOG ("too many occurrences thus not eliminated %d", pivot);
-    assert (!eliminator.schedule.contains (abs (pivot)));
-    return;
+    return 0;
   }
 
   LOG ("trying to eliminate %d", pivot);
@@ -693,11 +707,34 @@ void Internal::try_to_eliminate_variable (Eliminator &eliminator,
   Occs &ns = occs (-pivot);
   stable_sort (ns.begin (), ns.end (), clause_smaller_size ());
 
-  if (pos)
+  return pivot;
+}
+
+// The 'checked' argument is non-zero if the number of resolvents has
+// already been checked to be bounded (positive) or not (negative) without
+// gates by an 'ElimChecker' in the given number of 'resolutions' (see
+// 'elim_parallel_batch' below).  Since substitution only skips resolvents
+// the first result also holds with gates, the second one does not.
+
+void Internal::eliminate_prepared_variable (Eliminator &eliminator,
+                                            int pivot, int checked,
+                                            int64_t resolutions) {
+
+  assert (!eliminator.schedule.contains (abs (pivot)));
+
+  if (!occs (pivot).empty ())
     find_gate_clauses (eliminator, pivot);
 
   if (!unsat && !val (pivot)) {
-    if (elim_resolvents_are_bounded (eliminator, pivot)) {
+    bool bounded;
+    if (checked > 0 || (checked < 0 && eliminator.gates.empty ())) {
+      stats.elimtried++;
+      stats.elimres += resolutions;
+      stats.elimrestried += resolutions;
+      bounded = (checked > 0);
+    } else
+      bounded = elim_resolvents_are_bounded (eliminator, pivot);
+    if (bounded) {
       LOG ("number of resolvents on %d are bounded", pivot);
       elim_add_resolvents (eliminator, pivot);
       if (!unsat)
@@ -714,6 +751,252 @@ void Internal::try_to_eliminate_variable (Eliminator &eliminator,
 
 /*------------------------------------------------------------------------*/
 
+// With 'elimpar' candidates are taken from the schedule in batches, such
+// that the occurrence neighbourhoods of the candidates (all variables in
+// clauses with the candidate) are pairwise disjoint.  Then checking the
+// number of resolvents can be done for all candidates of a batch in
+// parallel on the unmodified occurrence lists, since eliminating one
+// candidate of the batch (including backward subsumption of its
+// resolvents) does not touch clauses of any other candidate.  Gate
+// detection, adding resolvents, pushing clauses on the extension stack and
+// tracing proofs is then done in the main thread in schedule order, which
+// makes the result independent of the number of threads.
+
+struct ElimCandidate {
+  int pivot;            // as returned by 'prepare_to_eliminate_variable'
+  int checked;          // see 'eliminate_prepared_variable'
+  int64_t resolutions;  // number of resolved clause pairs
+};
+
+struct ElimChecker {
+  Internal *internal;
+  vector<signed char> marks; // marked literals by 'vlit'
+  vector<int> marked;
+
+  ElimChecker (Internal *i)
+      : internal (i), marks (2 * (size_t) i->max_var + 2, 0) {}
+
+  int resolve (Clause *, int pivot, Clause *, int &size);
+  void check (ElimCandidate &);
+};
+
+// Same as 'resolve_clauses' but without side effects.  Returns '1' for a
+// non-tautological resolvent of size 'size', '0' for a tautological one
+// and '-1' if 'resolve_clauses' would modify clauses or assign units, in
+// which case the candidate has to be checked sequentially.
+
+int ElimChecker::resolve (Clause *c, int pivot, Clause *d, int &size) {
+  if (c->size > d->size) {
+    pivot = -pivot;
+    swap (c, d);
+  }
+  bool satisfied = false, tautological = false;
+  int s = 0, t = 0;
+  size = 0;
+  for (const auto &lit : *c) {
+    if (lit == pivot) {
+      s++;
+      continue;
+    }
+    const signed char tmp = internal->val (lit);
+    if (tmp > 0) {
+      satisfied = true;
+      break;
+    } else if (!tmp) {
+      marks[internal->vlit (lit)] = 1;
+      marked.push_back (lit);
+      size++, s++;
+    }
+  }
+  if (!satisfied)
+    for (const auto &lit : *d) {
+      if (lit == -pivot) {
+        t++;
+        continue;
+      }
+      const signed char tmp = internal->val (lit);
+      if (tmp > 0) {
+        satisfied = true;
+        break;
+      } else if (tmp < 0)
+        continue;
+      else if (marks[internal->vlit (-lit)]) {
+        tautological = true;
+        break;
+      } else if (!marks[internal->vlit (lit)])
+        size++;
+      t++;
+    }
+  for (const auto &lit : marked)
+    marks[internal->vlit (lit)] = 0;
+  marked.clear ();
+  if (satisfied)
+    return -1;
+  if (tautological)
+    return 0;
+  if (size < 2 || s > size || t > size)
+    return -1;
+  return 1;
+}
+
+// Same as 'elim_resolvents_are_bounded' without gates.
+
+void ElimChecker::check (ElimCandidate &candidate) {
+  const int pivot = candidate.pivot;
+  const Occs &ps = internal->occs (pivot);
+  const Occs &ns = internal->occs (-pivot);
+  const int64_t pos = ps.size ();
+  const int64_t neg = ns.size ();
+  const int64_t elimbound = internal->lim.elimbound;
+  if (!pos || !neg) {
+    candidate.checked = elimbound >= 0 ? 1 : -1;
+    return;
+  }
+  const int64_t bound = pos + neg + elimbound;
+  const int clslim = internal->opts.elimclslim;
+  int64_t resolvents = 0;
+  for (const auto &c : ps) {
+    if (c->garbage)
+      continue;
+    for (const auto &d : ns) {
+      if (d->garbage)
+        continue;
+      candidate.resolutions++;
+      int size;
+      const int res = resolve (c, pivot, d, size);
+      if (res < 0) {
+        candidate.checked = 0;
+        return;
+      }
+      if (!res)
+        continue;
+      if (size > clslim || ++resolvents > bound) {
+        candidate.checked = -1;
+        return;
+      }
+    }
+  }
+  candidate.checked = 1;
+}
+
+// Try to eliminate the next batch of candidates from the schedule and
+// return the number of tried candidates.
+
+int64_t Internal::elim_parallel_batch (Eliminator &eliminator,
+                                       vector<ElimChecker> &checkers) {
+
+  ElimSchedule &schedule = eliminator.schedule;
+  vector<bool> &batched = eliminator.batched;
+  if (batched.size () <= (size_t) max_var)
+    batched.resize (max_var + 1);
+
+  // Candidates with a neighbourhood overlapping the one of an earlier
+  // candidate of this batch are deferred to later batches.  In order not
+  // to scan the same candidates over and over again we stop as soon more
+  // candidates are deferred than taken.
+  //
+  vector<ElimCandidate> batch;
+  vector<int> deferred, neighbours;
+  int64_t tried = 0;
+  while ((int64_t) batch.size () < opts.elimparbatch &&
+         deferred.size () <= batch.size () && !schedule.empty ()) {
+    const int idx = schedule.front ();
+    schedule.pop_front ();
+    flags (idx).elim = false;
+    if (!active (idx)) {
+      tried++;
+      continue;
+    }
+    bool independent = true;
+    for (int sign = -1; independent && sign <= 1; sign += 2)
+      for (const auto &c : occs (sign * idx)) {
+        if (c->garbage)
+          continue;
+        for (const auto &lit : *c)
+          if (batched[abs (lit)]) {
+            independent = false;
+            break;
+          }
+        if (!independent)
+          break;
+      }
+    if (!independent) {
+      deferred.push_back (idx);
+      continue;
+    }
+    const int pivot = prepare_to_eliminate_variable (idx);
+    if (!pivot) {
+      tried++;
+      continue;
+    }
+    for (int sign = -1; sign <= 1; sign += 2)
+      for (const auto &c : occs (sign * pivot))
+        for (const auto &lit : *c) {
+          const int other = abs (lit);
+          if (batched[other])
+            continue;
+          batched[other] = true;
+          neighbours.push_back (other);
+        }
+    batch.push_back ({pivot, 0, 0});
+  }
+  for (const auto &idx : neighbours)
+    batched[idx] = false;
+  for (const auto &idx : deferred)
+    schedule.push_back (idx);
+
+  const size_t size = batch.size ();
+  if (!size)
+    return tried;
+
+  std::atomic<size_t> next (0);
+  auto work = [&] (ElimChecker &checker) {
+    for (;;) {
+      const size_t i = next.fetch_add (1, std::memory_order_relaxed);
+      if (i >= size)
+        break;
+      checker.check (batch[i]);
+    }
+  };
+
+  size_t jobs = checkers.size ();
+  if (jobs > size)
+    jobs = size;
+  LOG ("checking %zu elimination candidates with %zu threads", size, jobs);
+#ifndef NTHREADS
+  vector<std::thread> threads;
+  for (size_t i = 1; i < jobs; i++)
+    threads.push_back (std::thread (work, std::ref (checkers[i])));
+#endif
+  work (checkers[0]);
+#ifndef NTHREADS
+  for (auto &thread : threads)
+    thread.join ();
+#endif
+
+  // New units might have satisfied or shortened clauses of the remaining
+  // candidates, which then fall back to sequential elimination.
+  //
+  const int fixed = stats.all.fixed;
+  for (const auto &candidate : batch) {
+    if (unsat)
+      break;
+    tried++;
+    const int pivot = candidate.pivot;
+    if (!active (pivot))
+      continue;
+    if (stats.all.fixed == fixed)
+      eliminate_prepared_variable (eliminator, pivot, candidate.checked,
+                                   candidate.resolutions);
+    else if (!schedule.contains (abs (pivot)))
+      try_to_eliminate_variable (eliminator, pivot);
+  }
+
+  return tried;
+}
+
+/*------------------------------------------------------------------------*/
+
 void Internal::
     mark_redundant_clauses_with_eliminated_variables_as_garbage () {
   for (const auto &c : clauses) {
@@ -861,18 +1144,40 @@ int Internal::elim_round (bool &completed) {
   // schedule is updated dynamically and variables are potentially
   // rescheduled to be tried again if they occur in a removed clause.
   //
+  vector<ElimChecker> checkers;
+  if (opts.elimpar) {
+    size_t jobs = 1;
+#ifndef NTHREADS
+    jobs = opts.elimparjobs ? opts.elimparjobs
+                            : std::thread::hardware_concurrency ();
+    if (!jobs)
+      jobs = 1;
+#endif
+    PHASE ("elim-round", stats.elimrounds,
+           "parallel elimination with %zu threads", jobs);
+    for (size_t i = 0; i < jobs; i++)
+      checkers.push_back (ElimChecker (this));
+  }
+
 #ifndef QUIET
   int64_t tried = 0;
 #endif
   while (!unsat && !terminated_asynchronously () &&
          stats.elimres <= resolution_limit && !schedule.empty ()) {
-    int idx = schedule.front ();
-    schedule.pop_front ();
-    flags (idx).elim = false;
-    try_to_eliminate_variable (eliminator, idx);
+    if (opts.elimpar) {
 #ifndef QUIET
-    tried++;
+      tried +=
 #endif
+          elim_parallel_batch (eliminator, checkers);
+    } else {
+      int idx = schedule.front ();
+      schedule.pop_front ();
+      flags (idx).elim = false;
+      try_to_eliminate_variable (eliminator, idx);
+#ifndef QUIET
+      tried++;
+#endif
+    }
     if (stats.garbage.literals <= garbage_limit)
       continue;
     mark_redundant_clauses_with_eliminated_variables_as_garbage ();
@@ -30,6 +30,8 @@ struct Eliminator {
 
   vector<Clause *> gates;
   vector<int> marked;
+
+  vector<bool> batched; // variables in neighbourhood of batch ('elimpar')
 };
 
 } // namespace CaDiCaL
@@ -4,7 +4,8 @@ namespace CaDiCaL {
 
 External::External (Internal *i)
     : internal (i), max_var (0), vsize (0), extended (false),
-      terminator (0), learner (0), propagator (0), solution (0),
+      terminator (0), learner (0), batch_learner (0),
+      batched_conflicts (0), propagator (0), solution (0),
       vars (max_var) {
   assert (internal);
   assert (!internal->external);
@@ -353,7 +354,10 @@ void External::add_observed_var (int elit) {
 
   LOG ("notify propagator about fixed assignment upon observe for %d",
        unit);
-  propagator->notify_assignment (unit, true);
+  if (internal->external_prop_is_batched)
+    propagator->notify_assignments (&unit, 1, true);
+  else
+    propagator->notify_assignment (unit, true);
 }
 
 void External::remove_observed_var (int elit) {
@@ -505,6 +509,8 @@ int External::solve (bool preprocess_only) {
   reset_extended ();
   update_molten_literals ();
   int res = internal->solve (preprocess_only);
+  if (batch_learner)
+    flush_batched_clauses ();
   check_solve_result (res);
   reset_limits ();
   return res;
@@ -533,10 +539,10 @@ CaDiCaL::CubesWithStatus External::generate_cubes (int depth,
     MSG ("lookahead internal %d external %d", ilit, elit);
     return elit;
   };
-  auto externalize_map = [this, externalize] (std::vector<int> cube) {
+  auto externalize_map = [this, externalize] (std::vector<int> &cube) {
     (void) this;
     MSG ("Cube : ");
-    std::for_each (begin (cube), end (cube), externalize);
+    std::transform (begin (cube), end (cube), begin (cube), externalize);
   };
   std::for_each (begin (cubes.cubes), end (cubes.cubes), externalize_map);
 
@@ -803,7 +809,11 @@ void External::copy_flags (External &other) const {
 /*------------------------------------------------------------------------*/
 
 void External::export_learned_empty_clause () {
-  assert (learner);
+  assert (exporting ());
+  if (batch_learner)
+    export_batched_clause (0, 0, 0);
+  if (!learner)
+    return;
   if (learner->learning (0)) {
     LOG ("exporting learned empty clause");
     learner->learn (0);
@@ -812,7 +822,11 @@ void External::export_learned_empty_clause () {
 }
 
 void External::export_learned_unit_clause (int ilit) {
-  assert (learner);
+  assert (exporting ());
+  if (batch_learner)
+    export_batched_clause (&ilit, 1, 0);
+  if (!learner)
+    return;
   if (learner->learning (1)) {
     LOG ("exporting learned unit clause");
     const int elit = internal->externalize (ilit);
@@ -823,8 +837,13 @@ void External::export_learned_unit_clause (int ilit) {
     LOG ("not exporting learned unit clause");
 }
 
-void External::export_learned_large_clause (const vector<int> &clause) {
-  assert (learner);
+void External::export_learned_large_clause (const vector<int> &clause,
+                                            int glue) {
+  assert (exporting ());
+  if (batch_learner)
+    export_batched_clause (clause.data (), (int) clause.size (), glue);
+  if (!learner)
+    return;
   size_t size = clause.size ();
   assert (size <= (unsigned) INT_MAX);
   if (learner->learning ((int) size)) {
@@ -839,4 +858,63 @@ void External::export_learned_large_clause (const vector<int> &clause) {
     LOG ("not exporting learned clause of size %zu", size);
 }
 
+/*------------------------------------------------------------------------*/
+
+// Without buffering the clause is externalized into 'batched' and directly
+// given to the batch learner.  Otherwise it stays there (preceded by its
+// size and glue) until 'flush_batched_clauses' is called after the next
+// 'opts.learnbatch' conflicts or at the end of 'solve'.
+
+void External::export_batched_clause (const int *ilits, int size,
+                                      int glue) {
+  assert (batch_learner);
+  if (!batch_learner->learning (size, glue)) {
+    LOG ("not exporting batched clause of size %d", size);
+    return;
+  }
+  const int64_t interval = internal->opts.learnbatch;
+  if (!interval)
+    batched.clear ();
+  batched.push_back (size);
+  batched.push_back (glue);
+  for (int i = 0; i < size; i++) {
+    const int elit = internal->externalize (ilits[i]);
+    assert (elit);
+    batched.push_back (elit);
+  }
+  if (!interval) {
+    LOG ("exporting batched clause of size %d and glue %d", size, glue);
+    batch_learner->learn (batched.data () + 2, size, glue, size == 1);
+    batched.clear ();
+  } else if (internal->stats.conflicts - batched_conflicts >= interval)
+    flush_batched_clauses ();
+}
+
+void External::flush_batched_clauses () {
+  batched_conflicts = internal->stats.conflicts;
+  if (batched.empty ())
+    return;
+  assert (batch_learner);
+  LOG ("flushing %zd batched literals", batched.size ());
+  const int *p = batched.data (), *end = p + batched.size ();
+  while (p != end) {
+    const int size = *p++, glue = *p++;
+    batch_learner->learn (p, size, glue, size == 1);
+    p += size;
+  }
+  batched.clear ();
+  batch_learner->flush ();
+}
+
+/*------------------------------------------------------------------------*/
+
+void External::import_redundant_clause (const int *elits, size_t size,
+                                        int glue) {
+  assert (size <= (size_t) INT_MAX);
+  LOG ("queueing imported clause of size %zu and glue %d", size, glue);
+  imports.push_back ((int) size);
+  imports.push_back (glue);
+  imports.insert (imports.end (), elits, elits + size);
+}
+
 } // namespace CaDiCaL
@@ -91,9 +91,28 @@ struct External {
 
   Learner *learner;
 
+  // If there is a batch learner export learned clauses with their glue,
+  // buffered in 'batched' (as size, glue and literals) for 'learnbatch'
+  // conflicts if that option is non-zero.
+
+  BatchLearner *batch_learner;
+  vector<int> batched;
+  int64_t batched_conflicts; // conflicts at last flush
+
+  bool exporting () const { return learner || batch_learner; }
+
   void export_learned_empty_clause ();
   void export_learned_unit_clause (int ilit);
-  void export_learned_large_clause (const vector<int> &);
+  void export_learned_large_clause (const vector<int> &, int glue);
+  void export_batched_clause (const int *ilits, int size, int glue);
+  void flush_batched_clauses ();
+
+  // Redundant clauses imported through the API are queued in 'imports' (as
+  // size, glue and literals) until the next restart ('share.cpp').
+
+  vector<int> imports;
+
+  void import_redundant_clause (const int *elits, size_t size, int glue);
 
   // If there is an external propagator.
 
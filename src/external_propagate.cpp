@@ -329,13 +329,27 @@ void Internal::add_external_clause (int propagated_elit,
   assert (original.empty ());
   int elit = 0;
 
+  // With the batched interface the whole clause is obtained at once.
+  //
+  const int *lits = 0;
+  size_t size = 0, pos = 0;
+
   if (propagated_elit) {
 #ifndef NDEBUG
     LOG ("add external reason of propagated lit: %d", propagated_elit);
 #endif
-    elit = external->propagator->cb_add_reason_clause_lit (propagated_elit);
-  } else
+    if (external_prop_is_batched)
+      size = external->propagator->cb_add_reason_clause (propagated_elit,
+                                                         lits);
+    else
+      elit =
+          external->propagator->cb_add_reason_clause_lit (propagated_elit);
+  } else if (external_prop_is_batched)
+    size = external->propagator->cb_add_external_clause (lits);
+  else
     elit = external->propagator->cb_add_external_clause_lit ();
+  if (external_prop_is_batched && size)
+    elit = lits[pos++];
 
   // Read out the external lemma into original and simplify it into clause
   assert (clause.empty ());
@@ -349,7 +363,9 @@ void Internal::add_external_clause (int propagated_elit,
   while (elit) {
     assert (external->is_observed[abs (elit)]);
     external->add (elit);
-    if (propagated_elit)
+    if (external_prop_is_batched)
+      elit = pos < size ? lits[pos++] : 0;
+    else if (propagated_elit)
       elit =
           external->propagator->cb_add_reason_clause_lit (propagated_elit);
     else
@@ -366,8 +382,11 @@ void Internal::add_external_clause (int propagated_elit,
 //
 // Recursively calls 'learn_external_reason_clause' to explain every
 // backward reachable externally propagated literal starting from 'ilit'.
+// Literals assigned below level 'bound' are not explained but only marked
+// and saved on 'unexplained' (see 'explain_external_propagations').
 //
-void Internal::explain_reason (int ilit, Clause *reason, int &open) {
+void Internal::explain_reason (int ilit, Clause *reason, int &open,
+                               int bound, vector<int> &unexplained) {
 #ifndef NDEBUG
   LOG (reason, "explain_reason %d (open: %d)", ilit, open);
 #endif
@@ -382,6 +401,13 @@ void Internal::explain_reason (int ilit, Clause *reason, int &open) {
     Var &v = var (other);
     if (!v.level)
       continue;
+    if (v.level < bound) {
+      if (v.reason == external_reason) {
+        f.seen = true;
+        unexplained.push_back (other);
+      }
+      continue;
+    }
     assert (val (other) < 0);
     assert (v.level <= level);
     if (v.reason == external_reason) {
@@ -413,20 +439,55 @@ void Internal::explain_reason (int ilit, Clause *reason, int &open) {
 // guarantee that every relevant reason clause is indeed learned already and
 // to be sure that the levels of assignments are set correctly.
 //
-// Later TODO: experiment with bounded explanation (explain only those
-// literals that are directly used during conflict analysis +
-// minimizing/shrinking). The assignment levels are then only
-// over-approximated.
+// With 'opts.explainbound' the explanation is bounded to the conflict
+// level, i.e., only those literals are explained which are directly used
+// during conflict analysis.  Externally propagated literals on lower levels
+// keep their pseudo reason and thus their over-approximated assignment
+// level, which is sound but might yield a less precise backjump level.
+// Minimization and shrinking treat them as if they were decisions.  If the
+// explanation lowers the conflict level, the conflict level is explained
+// again until it does not change anymore.
 //
 void Internal::explain_external_propagations () {
   assert (conflict);
   assert (clause.empty ());
 
+  if (!opts.explainbound) {
+    explain_conflict_levels (0);
+    return;
+  }
+
+  int bound = conflict_max_level (), prev;
+  size_t unexplained;
+  do {
+    prev = bound;
+    unexplained = explain_conflict_levels (bound);
+    bound = conflict_max_level ();
+    assert (bound <= prev);
+  } while (bound < prev);
+  stats.ext_prop.eprop_unexplained += unexplained;
+}
+
+int Internal::conflict_max_level () {
+  int res = 0;
+  for (const auto &lit : *conflict) {
+    const int tmp = var (lit).level;
+    if (tmp > res)
+      res = tmp;
+  }
+  return res;
+}
+
+size_t Internal::explain_conflict_levels (int bound) {
+  assert (conflict);
+  assert (clause.empty ());
+
   Clause *reason = conflict;
-  std::vector<int> seen_lits;
+  std::vector<int> seen_lits, unexplained;
   int open = 0;          // Seen but not explained literal
 
-  explain_reason (0, reason, open); // marks conflict clause lits as seen
+  // marks conflict clause lits as seen
+  explain_reason (0, reason, open, bound, unexplained);
   if (!opts.reimply) {
   
     int i = trail.size (); // Start at end-of-trail
@@ -434,13 +495,15 @@ void Internal::explain_external_propagations () {
       const int lit = trail[--i];
       if (!flags (lit).seen)
         continue;
-      seen_lits.push_back (lit);
       Var &v = var (lit);
+      if (v.reason == external_reason)
+        continue; // unexplained below 'bound'
+      seen_lits.push_back (lit);
       if (!v.level)
         continue;
       if (v.reason) {
         open--;
-        explain_reason (lit, v.reason, open);
+        explain_reason (lit, v.reason, open, bound, unexplained);
       }
       if (!open)
         break;
@@ -452,13 +515,15 @@ void Internal::explain_external_propagations () {
         const int lit = *p;
         if (!flags (lit).seen)
           continue;
-        seen_lits.push_back (lit);
         Var &v = var (lit);
+        if (v.reason == external_reason)
+          continue; // unexplained below 'bound'
+        seen_lits.push_back (lit);
         if (!v.level || v.level != l)
           continue;
         if (v.reason) {
           open--;
-          explain_reason (lit, v.reason, open);
+          explain_reason (lit, v.reason, open, bound, unexplained);
         }
         if (!open)
           break;
@@ -508,12 +573,15 @@ void Internal::explain_external_propagations () {
     }
     f.seen = false;
   }
+  for (const auto &lit : unexplained)
+    flags (lit).seen = false;
 
 #ifndef NDEBUG
   for (auto idx : vars) {
     assert (!flags (idx).seen);
   }
 #endif
+  return unexplained.size ();
 }
 
 /*----------------------------------------------------------------------------*/
@@ -745,6 +813,20 @@ bool Internal::external_check_solution () {
   return !conflict;
 }
 
+/*----------------------------------------------------------------------------*/
+//
+// With the batched interface the external literals collected in
+// 'notify_batch' are passed to the propagator in one call.
+//
+void Internal::notify_batched_assignments () {
+  if (notify_batch.empty ())
+    return;
+  assert (external_prop_is_batched);
+  external->propagator->notify_assignments (notify_batch.data (),
+                                            notify_batch.size (), false);
+  notify_batch.clear ();
+}
+
 /*----------------------------------------------------------------------------*/
 //
 // Notify the external propagator that an observed variable got assigned.
@@ -765,8 +847,12 @@ void Internal::notify_assignments () {
       int elit = externalize (ilit); // TODO: double-check tainting
       assert (elit);
       assert (external->observed (elit));
-      external->propagator->notify_assignment (elit, false);
+      if (external_prop_is_batched)
+        notify_batch.push_back (elit);
+      else
+        external->propagator->notify_assignment (elit, false);
     }
+    notify_batched_assignments ();
     return;
   }
   // TODO: multitrail
@@ -783,8 +869,12 @@ void Internal::notify_assignments () {
     int elit = externalize (ilit); // TODO: double-check tainting
     assert (elit);
     assert (external->observed (elit));
-    external->propagator->notify_assignment (elit, false);
+    if (external_prop_is_batched)
+      notify_batch.push_back (elit);
+    else
+      external->propagator->notify_assignment (elit, false);
   }
+  notify_batched_assignments ();
 #ifndef NDEBUG
   for (auto idx : vars) {
     Flags & f = flags (idx);
@@ -11,8 +11,25 @@ extern "C" {
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#ifndef __WIN32
+#include <sys/mman.h>
+#endif
 }
 
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -29,7 +46,9 @@ File::File (Internal *i, bool w, int c, FILE *f, const char *n)
 #if !defined(QUIET) || !defined(NDEBUG)
       writing (w),
 #endif
-      close_file (c), file (f), _name (n), _lineno (1), _bytes (0) {
+      close_file (c), file (f), _name (n), _lineno (1), _bytes (0),
+      block (0), spare (0), filled (0), capacity (0), writer (0),
+      _blocks (0), _blocked (0) {
   (void) i, (void) w;
   assert (f), assert (n);
 }
@@ -217,6 +236,17 @@ FILE *File::read_pipe (Internal *internal, const char *fmt, const int *sig,
   return open_pipe (internal, fmt, path, "r");
 }
 
+FILE *File::read_stream (Internal *internal,
+                         FILE *(*open) (Internal *, const char *,
+                                        const char *),
+                         const int *sig, const char *path) {
+  if (!File::exists (path))
+    return 0;
+  if (sig && !File::match (internal, path, sig))
+    return 0;
+  return open (internal, path, "r");
+}
+
 FILE *File::write_pipe (Internal *internal, const char *fmt,
                         const char *path) {
   MSG ("opening pipe to write '%s'", path);
@@ -225,6 +255,169 @@ FILE *File::write_pipe (Internal *internal, const char *fmt,
 
 /*------------------------------------------------------------------------*/
 
+// If 'configure' found 'zlib' or 'liblzma' we decompress and compress
+// 'gzip' and 'xz' (and 'lzma') files in-process through a custom 'FILE'
+// stream, which avoids spawning helper processes and copying data through
+// a pipe.  The rest of 'File' (and thus the parser and proof tracers)
+// still uses the unlocked character functions on that stream.
+
+#ifdef HAVE_ZLIB
+
+static ssize_t gzip_read (void *cookie, char *buf, size_t size) {
+  if (size > INT_MAX)
+    size = INT_MAX;
+  return gzread ((gzFile) cookie, buf, (unsigned) size);
+}
+
+static ssize_t gzip_write (void *cookie, const char *buf, size_t size) {
+  if (!size)
+    return 0;
+  if (size > INT_MAX)
+    size = INT_MAX;
+  const int res = gzwrite ((gzFile) cookie, buf, (unsigned) size);
+  return res > 0 ? res : -1;
+}
+
+static int gzip_close (void *cookie) {
+  return gzclose ((gzFile) cookie) == Z_OK ? 0 : EOF;
+}
+
+FILE *File::open_gzip (Internal *internal, const char *path,
+                       const char *mode) {
+  MSG ("opening 'zlib' stream to %s '%s'", *mode == 'r' ? "read" : "write",
+       path);
+  gzFile gz = gzopen (path, *mode == 'r' ? "rb" : "wb");
+  if (!gz)
+    return 0;
+  gzbuffer (gz, 1u << 17);
+  cookie_io_functions_t functions;
+  functions.read = gzip_read;
+  functions.write = gzip_write;
+  functions.seek = 0;
+  functions.close = gzip_close;
+  FILE *res = fopencookie (gz, *mode == 'r' ? "r" : "w", functions);
+  if (!res)
+    gzclose (gz);
+  return res;
+}
+
+#endif
+
+#ifdef HAVE_LZMA
+
+struct LzmaCookie {
+  FILE *file; // underlying compressed file
+  lzma_stream stream;
+  bool writing, eof;
+  uint8_t buffer[1u << 16];
+};
+
+static ssize_t lzma_read (void *cookie, char *buf, size_t size) {
+  LzmaCookie *c = (LzmaCookie *) cookie;
+  lzma_stream &stream = c->stream;
+  stream.next_out = (uint8_t *) buf;
+  stream.avail_out = size;
+  while (stream.avail_out) {
+    if (!stream.avail_in && !c->eof) {
+      stream.next_in = c->buffer;
+      stream.avail_in = fread (c->buffer, 1, sizeof c->buffer, c->file);
+      if (!stream.avail_in) {
+        if (ferror (c->file))
+          return -1;
+        c->eof = true;
+      }
+    }
+    const lzma_ret ret = lzma_code (&stream, c->eof ? LZMA_FINISH : LZMA_RUN);
+    if (ret == LZMA_STREAM_END)
+      break;
+    if (ret != LZMA_OK)
+      return -1;
+  }
+  return size - stream.avail_out;
+}
+
+static bool lzma_flush (LzmaCookie *c, lzma_action action,
+                        lzma_ret &ret) {
+  lzma_stream &stream = c->stream;
+  stream.next_out = c->buffer;
+  stream.avail_out = sizeof c->buffer;
+  ret = lzma_code (&stream, action);
+  const size_t bytes = sizeof c->buffer - stream.avail_out;
+  return fwrite (c->buffer, 1, bytes, c->file) == bytes;
+}
+
+static ssize_t lzma_write (void *cookie, const char *buf, size_t size) {
+  LzmaCookie *c = (LzmaCookie *) cookie;
+  lzma_stream &stream = c->stream;
+  stream.next_in = (const uint8_t *) buf;
+  stream.avail_in = size;
+  while (stream.avail_in) {
+    lzma_ret ret;
+    if (!lzma_flush (c, LZMA_RUN, ret) || ret != LZMA_OK)
+      return -1;
+  }
+  return size;
+}
+
+static int lzma_close (void *cookie) {
+  LzmaCookie *c = (LzmaCookie *) cookie;
+  int res = 0;
+  if (c->writing)
+    for (;;) {
+      lzma_ret ret;
+      if (!lzma_flush (c, LZMA_FINISH, ret) ||
+          (ret != LZMA_OK && ret != LZMA_STREAM_END)) {
+        res = EOF;
+        break;
+      }
+      if (ret == LZMA_STREAM_END)
+        break;
+    }
+  lzma_end (&c->stream);
+  if (fclose (c->file))
+    res = EOF;
+  delete c;
+  return res;
+}
+
+FILE *File::open_lzma (Internal *internal, const char *path,
+                       const char *mode) {
+  const bool writing = (*mode == 'w');
+  MSG ("opening 'liblzma' stream to %s '%s'", writing ? "write" : "read",
+       path);
+  FILE *file = fopen (path, writing ? "wb" : "rb");
+  if (!file)
+    return 0;
+  LzmaCookie *c = new LzmaCookie;
+  c->file = file;
+  c->stream = LZMA_STREAM_INIT;
+  c->writing = writing;
+  c->eof = false;
+  const lzma_ret ret =
+      writing ? lzma_easy_encoder (&c->stream, 6, LZMA_CHECK_CRC64)
+              : lzma_auto_decoder (&c->stream, UINT64_MAX,
+                                   LZMA_CONCATENATED);
+  FILE *res = 0;
+  if (ret == LZMA_OK) {
+    cookie_io_functions_t functions;
+    functions.read = lzma_read;
+    functions.write = lzma_write;
+    functions.seek = 0;
+    functions.close = lzma_close;
+    res = fopencookie (c, writing ? "w" : "r", functions);
+  }
+  if (!res) {
+    lzma_end (&c->stream);
+    fclose (file);
+    delete c;
+  }
+  return res;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 File *File::read (Internal *internal, FILE *f, const char *n) {
   return new File (internal, false, 0, f, n);
 }
@@ -237,11 +430,21 @@ File *File::read (Internal *internal, const char *path) {
   FILE *file;
   int close_input = 2;
   if (has_suffix (path, ".xz")) {
+#ifdef HAVE_LZMA
+    file = read_stream (internal, open_lzma, xzsig, path);
+    close_input = 3;
+#else
     file = read_pipe (internal, "xz -c -d %s", xzsig, path);
+#endif
     if (!file)
       goto READ_FILE;
   } else if (has_suffix (path, ".lzma")) {
+#ifdef HAVE_LZMA
+    file = read_stream (internal, open_lzma, lzmasig, path);
+    close_input = 3;
+#else
     file = read_pipe (internal, "lzma -c -d %s", lzmasig, path);
+#endif
     if (!file)
       goto READ_FILE;
   } else if (has_suffix (path, ".bz2")) {
@@ -249,7 +452,12 @@ File *File::read (Internal *internal, const char *path) {
     if (!file)
       goto READ_FILE;
   } else if (has_suffix (path, ".gz")) {
+#ifdef HAVE_ZLIB
+    file = read_stream (internal, open_gzip, gzsig, path);
+    close_input = 3;
+#else
     file = read_pipe (internal, "gzip -c -d %s", gzsig, path);
+#endif
     if (!file)
       goto READ_FILE;
   } else if (has_suffix (path, ".7z")) {
@@ -268,13 +476,21 @@ File *File::read (Internal *internal, const char *path) {
 File *File::write (Internal *internal, const char *path) {
   FILE *file;
   int close_input = 2;
-  if (has_suffix (path, ".xz"))
+  if (has_suffix (path, ".xz")) {
+#ifdef HAVE_LZMA
+    file = open_lzma (internal, path, "w"), close_input = 3;
+#else
     file = write_pipe (internal, "xz -c > %s", path);
-  else if (has_suffix (path, ".bz2"))
+#endif
+  } else if (has_suffix (path, ".bz2"))
     file = write_pipe (internal, "bzip2 -c > %s", path);
-  else if (has_suffix (path, ".gz"))
+  else if (has_suffix (path, ".gz")) {
+#ifdef HAVE_ZLIB
+    file = open_gzip (internal, path, "w"), close_input = 3;
+#else
     file = write_pipe (internal, "gzip -c > %s", path);
-  else if (has_suffix (path, ".7z"))
+#endif
+  } else if (has_suffix (path, ".7z"))
     file = write_pipe (internal, "7z a -an -txz -si -so > %s 2>/dev/null",
                        path);
   else
@@ -283,8 +499,197 @@ File *File::write (Internal *internal, const char *path) {
   return file ? new File (internal, true, close_input, file, path) : 0;
 }
 
+/*------------------------------------------------------------------------*/
+
+const char *File::map (size_t &size, size_t &offset) {
+  assert (!writing);
+#ifdef __WIN32
+  (void) size, (void) offset;
+  return 0;
+#else
+  const int fd = fileno (file);
+  struct stat buf;
+  if (fd < 0 || fstat (fd, &buf) || !S_ISREG (buf.st_mode))
+    return 0;
+  const long pos = ftell (file);
+  if (pos < 0 || (uint64_t) pos >= (uint64_t) buf.st_size)
+    return 0;
+  void *res = mmap (0, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (res == MAP_FAILED)
+    return 0;
+  (void) madvise (res, buf.st_size, MADV_SEQUENTIAL);
+  size = buf.st_size;
+  offset = pos;
+  MSG ("mapped %zu bytes of '%s'", size, name ());
+  return (const char *) res;
+#endif
+}
+
+void File::unmap (const char *start, size_t size) {
+#ifdef __WIN32
+  (void) start, (void) size;
+#else
+  munmap ((void *) start, size);
+#endif
+}
+
+bool File::seek (size_t offset, uint64_t lineno) {
+  assert (!writing);
+  if (fseek (file, (long) offset, SEEK_SET))
+    return false;
+  _lineno = lineno;
+  _bytes = offset;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Buffered writing through blocks.  Without a background writer full
+// blocks are simply written with 'fwrite', which still saves the per
+// character overhead of 'putc'.  With a writer thread we keep exactly two
+// blocks, one filled by 'put' and one written by the thread, which bounds
+// the memory used to twice the block size.  If the solver produces data
+// faster than it can be written it has to wait for the writer to finish
+// the previous block (and this waiting time is accumulated in 'blocked').
+
+#ifndef NTHREADS
+
+struct FileWriter {
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cond;
+  FILE *file;
+  const char *pending; // block handed over to the writer (if non-zero)
+  size_t size;         // number of bytes in the pending block
+  bool stop, failed;
+  FileWriter (FILE *f)
+      : file (f), pending (0), size (0), stop (false), failed (false) {}
+  void run ();
+};
+
+void FileWriter::run () {
+  std::unique_lock<std::mutex> lock (mutex);
+  for (;;) {
+    cond.wait (lock, [this] { return pending || stop; });
+    if (!pending)
+      break;
+    const char *data = pending;
+    const size_t bytes = size;
+    lock.unlock ();
+    const bool ok = fwrite (data, 1, bytes, file) == bytes;
+    lock.lock ();
+    if (!ok)
+      failed = true;
+    pending = 0;
+    cond.notify_all ();
+  }
+  lock.unlock ();
+  if (fflush (file))
+    failed = true;
+#ifndef __WIN32
+  const int fd = fileno (file);
+  struct stat buf;
+  if (fd >= 0 && !fstat (fd, &buf) && S_ISREG (buf.st_mode))
+    (void) fsync (fd);
+#endif
+}
+
+#endif
+
+void File::buffer (size_t bytes, bool async) {
+  assert (writing);
+  assert (!block);
+  if (!bytes)
+    return;
+  // Other data (like messages on '<stdout>') might be written to files we
+  // do not own.  Since blocks end at arbitrary positions and not at line
+  // boundaries, such data would end up in the middle of our lines.
+  if (!close_file)
+    return;
+  fflush (file);
+  capacity = bytes;
+  block = new char[capacity];
+#ifndef NTHREADS
+  if (async) {
+    MSG ("writing '%s' asynchronously in blocks of %zu bytes", name (),
+         bytes);
+    spare = new char[capacity];
+    writer = new FileWriter (file);
+    writer->thread = std::thread (&FileWriter::run, writer);
+  }
+#else
+  (void) async;
+#endif
+}
+
+bool File::write_block () {
+  assert (block);
+  if (!filled)
+    return true;
+  _blocks++;
+#ifndef NTHREADS
+  if (writer) {
+    std::unique_lock<std::mutex> lock (writer->mutex);
+    if (writer->pending) {
+      const double start = absolute_real_time ();
+      writer->cond.wait (lock, [this] { return !writer->pending; });
+      _blocked += absolute_real_time () - start;
+    }
+    if (writer->failed)
+      return false;
+    writer->pending = block;
+    writer->size = filled;
+    writer->cond.notify_all ();
+    std::swap (block, spare);
+    filled = 0;
+    return true;
+  }
+#endif
+  const bool res = fwrite (block, 1, filled, file) == filled;
+  filled = 0;
+  return res;
+}
+
+// Write all buffered data and wait for the writer to finish (if 'stop' is
+// set the writer thread is joined and deleted).
+
+#ifndef NTHREADS
+
+static void drain (FileWriter *writer, bool stop, double &blocked) {
+  const double start = absolute_real_time ();
+  if (stop) {
+    {
+      std::lock_guard<std::mutex> lock (writer->mutex);
+      writer->stop = true;
+      writer->cond.notify_all ();
+    }
+    writer->thread.join ();
+  } else {
+    std::unique_lock<std::mutex> lock (writer->mutex);
+    writer->cond.wait (lock, [writer] { return !writer->pending; });
+  }
+  blocked += absolute_real_time () - start;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 void File::close () {
   assert (file);
+  if (block) {
+    write_block ();
+#ifndef NTHREADS
+    if (writer) {
+      drain (writer, true, _blocked);
+      delete writer;
+      writer = 0;
+    }
+#endif
+    delete[] block;
+    delete[] spare;
+    block = spare = 0;
+  }
   if (close_file == 0) {
     MSG ("disconnecting from '%s'", name ());
   }
@@ -296,6 +701,10 @@ void File::close () {
     MSG ("closing pipe command on '%s'", name ());
     pclose (file);
   }
+  if (close_file == 3) {
+    MSG ("closing compressed stream on '%s'", name ());
+    fclose (file);
+  }
 
   file = 0; // mark as closed
 
@@ -307,7 +716,7 @@ void File::close () {
     MSG ("after writing %" PRIu64 " bytes %.1f MB", bytes (), mb);
   else
     MSG ("after reading %" PRIu64 " bytes %.1f MB", bytes (), mb);
-  if (close_file == 2) {
+  if (close_file >= 2) {
     int64_t s = size (name ());
     double mb = s / (double) (1 << 20);
     if (writing)
@@ -324,6 +733,13 @@ void File::close () {
 
 void File::flush () {
   assert (file);
+  if (block) {
+    write_block ();
+#ifndef NTHREADS
+    if (writer)
+      drain (writer, false, _blocked);
+#endif
+  }
   fflush (file);
 }
 
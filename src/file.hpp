@@ -24,9 +24,11 @@ namespace CaDiCaL {
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
 // through 'popen' using external helper tools.  Reading has line numbers.
 // Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH', unless 'zlib'
+// respectively 'liblzma' are linked ('HAVE_ZLIB' and 'HAVE_LZMA').
 
 struct Internal;
+struct FileWriter;
 
 class File {
 
@@ -37,12 +39,24 @@ class File {
   bool writing;
 #endif
 
-  int close_file; // need to close file (1=fclose, 2=pclose)
+  int close_file; // need to close file (1=fclose, 2=pclose, 3=stream)
   FILE *file;
   const char *_name;
   uint64_t _lineno;
   uint64_t _bytes;
 
+  // Optionally written data is collected in blocks instead of passing each
+  // character to the 'C' library.  Full blocks are written by a background
+  // 'writer' thread if there is one, while 'put' fills the 'spare' block.
+
+  char *block, *spare;
+  size_t filled, capacity;
+  FileWriter *writer;
+  uint64_t _blocks; // number of blocks written
+  double _blocked;  // time waiting for the writer to catch up
+
+  bool write_block ();
+
   File (Internal *, bool, int, FILE *, const char *);
 
   static FILE *open_file (Internal *, const char *path, const char *mode);
@@ -55,6 +69,17 @@ class File {
                           const char *path);
   static FILE *write_pipe (Internal *, const char *fmt, const char *path);
 
+#ifdef HAVE_ZLIB
+  static FILE *open_gzip (Internal *, const char *path, const char *mode);
+#endif
+#ifdef HAVE_LZMA
+  static FILE *open_lzma (Internal *, const char *path, const char *mode);
+#endif
+  static FILE *read_stream (Internal *,
+                            FILE *(*open) (Internal *, const char *,
+                                           const char *),
+                            const int *sig, const char *path);
+
 public:
   static char *find (const char *prg);     // search in 'PATH'
   static bool exists (const char *path);   // file exists?
@@ -97,7 +122,11 @@ public:
 
   bool put (char ch) {
     assert (writing);
-    if (cadical_putc_unlocked (ch, file) == EOF)
+    if (block) {
+      if (filled == capacity && !write_block ())
+        return false;
+      block[filled++] = ch;
+    } else if (cadical_putc_unlocked (ch, file) == EOF)
       return false;
     _bytes++;
     return true;
@@ -105,7 +134,11 @@ public:
 
   bool put (unsigned char ch) {
     assert (writing);
-    if (cadical_putc_unlocked (ch, file) == EOF)
+    if (block) {
+      if (filled == capacity && !write_block ())
+        return false;
+      block[filled++] = ch;
+    } else if (cadical_putc_unlocked (ch, file) == EOF)
       return false;
     _bytes++;
     return true;
@@ -183,9 +216,30 @@ public:
     }
   }
 
+  // Map a regular file being read into memory, which allows to parse it
+  // much faster (and in parallel).  Returns zero if this is not possible,
+  // e.g., for pipes of compressed files.  Otherwise returns the start of
+  // the whole mapped file, its 'size' and the current read 'offset'.
+  //
+  const char *map (size_t &size, size_t &offset);
+  void unmap (const char *, size_t size);
+
+  // Continue reading at 'offset' which is in line 'lineno'.
+  //
+  bool seek (size_t offset, uint64_t lineno);
+
+  // Collect written data in blocks of the given size.  If 'async' is set
+  // (and threads are available) blocks are written by a background thread
+  // and only if that thread falls behind by a full block we wait for it.
+  // Files not opened by us (such as '<stdout>') are never buffered.
+  //
+  void buffer (size_t bytes, bool async);
+
   const char *name () const { return _name; }
   uint64_t lineno () const { return _lineno; }
   uint64_t bytes () const { return _bytes; }
+  uint64_t blocks () const { return _blocks; }
+  double blocked () const { return _blocked; }
 
   bool closed () { return !file; }
   void close ();
@@ -7,7 +7,10 @@ void Internal::mark_fixed (int lit) {
     int elit = externalize (lit);
     assert (elit && external->observed (elit));
 
-    external->propagator->notify_assignment (elit, true);
+    if (external_prop_is_batched)
+      external->propagator->notify_assignments (&elit, 1, true);
+    else
+      external->propagator->notify_assignment (elit, true);
     // Does not increase the notified counter because
     // it is a separated way of notification.
   }
@@ -11,17 +11,18 @@ Internal::Internal ()
       protected_reasons (false), force_saved_phase (false),
       searching_lucky_phases (false), stable (false), reported (false),
       external_prop (false), did_external_prop (false),
-      external_prop_is_lazy (true), rephased (0), vsize (0), max_var (0),
-      clause_id (0), original_id (0), reserved_ids (0), conflict_id (0),
-      level (0), vals (0), score_inc (1.0), scores (this), conflict (0),
-      ignore (0), external_reason (&external_reason_clause),
-      newest_clause (0), force_no_backtrack (false), from_propagator (false),
-      tainted_literal (0), notified (0), probe_reason (0),
-      propagated (0), propagated2 (0), propergated (0), best_assigned (0),
-      target_assigned (0), no_conflict_until (0), unsat_constraint (false),
-      marked_failed (true), multitrail_dirty (0), num_assigned (0),
-      proof (0), checker (0), tracer (0),
-      lratchecker (0), lratbuilder (0), opts (this),
+      external_prop_is_lazy (true), external_prop_is_batched (false),
+      rephased (0), vsize (0), max_var (0), clause_id (0), original_id (0),
+      reserved_ids (0), conflict_id (0), level (0), vals (0),
+      avx2 (avx2_supported ()), score_inc (1.0), scores (this),
+      conflict (0), ignore (0), external_reason (&external_reason_clause),
+      newest_clause (0), force_no_backtrack (false),
+      from_propagator (false), tainted_literal (0), notified (0),
+      probe_reason (0), propagated (0), propagated2 (0), propergated (0),
+      best_assigned (0), target_assigned (0), no_conflict_until (0),
+      unsat_constraint (false), marked_failed (true), multitrail_dirty (0),
+      num_assigned (0), proof (0), checker (0), tracer (0), lratchecker (0),
+      lratbuilder (0), sharer (0), opts (this),
 #ifndef QUIET
       profiles (this), force_phase_messages (false),
 #endif
@@ -45,7 +46,7 @@ Internal::~Internal () {
   if (lratbuilder)
     delete lratbuilder;
   if (vals) {
-    vals -= vsize;
+    vals -= vsize + 3;
     delete[] vals;
   }
   clear_trails (0);
@@ -68,21 +69,24 @@ Internal::~Internal () {
 // as far I can tell is properly defined C / C++).   You might get a warning
 // by static analyzers though.  Clang with '--analyze' thought that this
 // idiom would generate a memory leak thus we use the following dummy.
+// The three additional bytes in front are only read by the vectorized
+// scan of clauses in 'simd.cpp' (they are never set).
 
 static signed char *ignore_clang_analyze_memory_leak_warning;
 
 void Internal::enlarge_vals (size_t new_vsize) {
   signed char *new_vals;
-  const size_t bytes = 2u * new_vsize;
+  const size_t bytes = 2u * new_vsize + 3;
   new_vals = new signed char[bytes]; // g++-4.8 does not like ... { 0 };
   memset (new_vals, 0, bytes);
   ignore_clang_analyze_memory_leak_warning = new_vals;
-  new_vals += new_vsize;
+  new_vals += new_vsize + 3;
 
-  if (vals)
+  if (vals) {
     memcpy (new_vals - max_var, vals - max_var, 2u * max_var + 1u);
-  vals -= vsize;
-  delete[] vals;
+    vals -= vsize + 3;
+    delete[] vals;
+  }
   vals = new_vals;
 }
 
@@ -134,6 +138,7 @@ void Internal::enlarge (int new_max_var) {
   enlarge_zero (phases.min, new_vsize);
   enlarge_zero (marks, new_vsize);
   vsize = new_vsize;
+  bin_graph.valid = false;
 }
 
 void Internal::init_vars (int new_max_var) {
@@ -239,6 +244,8 @@ int Internal::cdcl_loop_with_inprocessing () {
       break;                               // decision or conflict limit
     else if (terminated_asynchronously ()) // externally terminated
       break;
+    else if (importing ())
+      import_shared_clauses (); // clauses from other workers
     else if (restarting ())
       restart (); // restart by backtracking
     else if (rephasing ())
@@ -848,6 +855,8 @@ void Internal::print_statistics () {
   stats.print (this);
   if (checker)
     checker->print_stats ();
+  if (lratchecker)
+    lratchecker->print_stats ();
 }
 
 /*------------------------------------------------------------------------*/
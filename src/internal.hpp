@@ -86,6 +86,8 @@ extern "C" {
 #include "reluctant.hpp"
 #include "resources.hpp"
 #include "score.hpp"
+#include "share.hpp"
+#include "simd.hpp"
 #include "stats.hpp"
 #include "terminal.hpp"
 #include "tracer.hpp"
@@ -102,7 +104,9 @@ namespace CaDiCaL {
 using namespace std;
 
 struct Coveror;
+struct ElimChecker;
 struct External;
+struct VivifyWorkers;
 struct Walker;
 
 struct CubesWithStatus {
@@ -164,6 +168,7 @@ struct Internal {
   bool external_prop;         // true if an external propagator is connected
   bool did_external_prop;     // true if ext. propagation happened
   bool external_prop_is_lazy; // true if the external propagator is lazy
+  bool external_prop_is_batched; // true if it uses the batched interface
   char rephased;              // last type of resetting phases
   Reluctant reluctant;        // restart counter in stable mode
   size_t vsize;               // actually allocated variable data size
@@ -183,6 +188,7 @@ struct Internal {
   int level;                    // decision level ('control.size () - 1')
   Phases phases;                // saved, target and best phases
   signed char *vals;            // assignment [-max_var,max_var]
+  bool avx2;                    // vectorized clause scanning supported
   vector<signed char> marks;    // signed marks [1,max_var]
   vector<unsigned> frozentab;   // frozen counters [1,max_var]
   vector<int> i2e;              // maps internal 'idx' to external 'lit'
@@ -201,6 +207,7 @@ struct Internal {
   vector<int> ptab;             // table for caching probing attempts
   vector<int64_t> ntab;         // number of one-sided occurrences table
   vector<Bins> big;             // binary implication graph
+  BinGraph bin_graph;           // snapshot of binary implication graph
   vector<Watches> wtab;         // table of watches for all literals
   Clause *conflict;             // set in 'propagation', reset in 'analyze'
   vector<Clause *> conflicts;   // set in propagate for opts.reimply
@@ -213,6 +220,7 @@ struct Internal {
   vector<Clause *> fix_later;   // for reimply + external propagator
   vector<int> notify_trail;     // for reimply + external propagator
   size_t notified;              // next trail position to notify external prop
+  vector<int> notify_batch;     // batched notifications for external prop
   Clause *probe_reason;         // set during probing
   size_t propagated;            // next trail position to propagate
   size_t propagated2;         // next binary trail position to propagate
@@ -252,6 +260,7 @@ struct Internal {
   Tracer *tracer;           // proof to file tracer observing proof
   LratChecker *lratchecker; // online lrat checker observing proof
   LratBuilder *lratbuilder; // lrat proof chain builder observing proof
+  Sharer *sharer;           // portfolio clause sharing if non zero
   Options opts;             // run-time options
   Stats stats;              // statistics
 #ifndef QUIET
@@ -381,6 +390,12 @@ struct Internal {
   bool watching () const { return !wtab.empty (); }
 
   Bins &bins (int lit) { return big[vlit (lit)]; }
+  BinEdges bin_edges (int lit) {
+    assert (vlit (lit) + 1 < bin_graph.offsets.size ());
+    const BinEdge *edges = bin_graph.edges.data ();
+    const unsigned *offsets = bin_graph.offsets.data () + vlit (lit);
+    return BinEdges{edges + offsets[0], edges + offsets[1]};
+  }
   Occs &occs (int lit) { return otab[vlit (lit)]; }
   int64_t &noccs (int lit) { return ntab[vlit (lit)]; }
   Watches &watches (int lit) { return wtab[vlit (lit)]; }
@@ -550,7 +565,7 @@ struct Internal {
   // Managing clauses in 'clause.cpp'.  Without explicit 'Clause' argument
   // these functions work on the global temporary 'clause'.
   //
-  Clause *new_clause (bool red, int glue = 0);
+  Clause *new_clause (bool red, int glue = 0, uint64_t id = 0);
   void promote_clause (Clause *, int new_glue);
   size_t shrink_clause (Clause *, int new_size);
   void minimize_sort_clause ();
@@ -655,9 +670,13 @@ struct Internal {
   Clause *learn_external_reason_clause (int lit, int falsified_elit = 0,
                                         bool no_backtrack = false);
   void explain_external_propagations ();
-  void explain_reason (int lit, Clause *, int &open);
+  size_t explain_conflict_levels (int bound);
+  int conflict_max_level ();
+  void explain_reason (int lit, Clause *, int &open, int bound,
+                       vector<int> &unexplained);
   void move_literal_to_watch (bool other_watch);
   void handle_external_clause (Clause *);
+  void notify_batched_assignments ();
   void notify_assignments ();
   void notify_decision ();
   void notify_backtrack (size_t new_level);
@@ -681,6 +700,16 @@ struct Internal {
   int reuse_trail ();
   void restart ();
 
+  // Clause sharing between portfolio workers in 'share.cpp'.
+  //
+  void export_shared_unit (int ilit);
+  void export_shared_clause (int glue);
+  bool importable ();
+  bool importing ();
+  void import_shared_clause (const int *elits, int size, int glue);
+  void import_shared_clauses ();
+  void import_queued_clauses ();
+
   // Functions to set and reset certain 'phases'.
   //
   void clear_phases (vector<signed char> &); // reset argument to zero
@@ -741,6 +770,7 @@ struct Internal {
   int clause_contains_fixed_literal (Clause *);
   void remove_falsified_literals (Clause *);
   void mark_satisfied_clauses_as_garbage ();
+  bool moving_clause (Clause *, bool major);
   void copy_clause (Clause *);
   void flush_watches (int lit, Watches &);
   size_t flush_occs (int lit);
@@ -762,6 +792,11 @@ struct Internal {
   void reset_bins ();
   void reset_noccs ();
 
+  // Compressed binary implication graph in 'bins.cpp'.
+  //
+  void update_bin_graph ();
+  void add_bin_graph_edges (Clause *);
+
   // Operators on watches.
   //
   void init_watches ();
@@ -776,7 +811,8 @@ struct Internal {
   void strengthen_clause (Clause *, int);
   void subsume_clause (Clause *subsuming, Clause *subsumed);
   int subsume_check (Clause *subsuming, Clause *subsumed);
-  int try_to_subsume_clause (Clause *, vector<Clause *> &shrunken);
+  int try_to_subsume_clause (Clause *, vector<Clause *> &shrunken,
+                             const vector<vector<uint64_t>> &sigs);
   void reset_subsume_bits ();
   bool subsume_round ();
   void subsume (bool update_limits = true);
@@ -806,6 +842,7 @@ struct Internal {
   void vivify_assume (int lit);
   bool vivify_propagate ();
   void vivify_clause (Vivifier &, Clause *candidate);
+  void vivify_check_block (Vivifier &, VivifyWorkers &);
   void vivify_round (bool redundant_mode, int64_t delta);
   void vivify ();
 
@@ -1003,6 +1040,11 @@ struct Internal {
   void elim_propagate (Eliminator &, int unit);
   void elim_on_the_fly_self_subsumption (Eliminator &, Clause *, int);
   void try_to_eliminate_variable (Eliminator &, int pivot);
+  int prepare_to_eliminate_variable (int pivot);
+  void eliminate_prepared_variable (Eliminator &, int pivot,
+                                    int checked = 0,
+                                    int64_t resolutions = 0);
+  int64_t elim_parallel_batch (Eliminator &, vector<ElimChecker> &);
   void increase_elimination_bound ();
   int elim_round (bool &completed);
   void elim (bool update_limits = true);
@@ -1066,12 +1108,17 @@ struct Internal {
   void probe_dominator_lrat (int dom, Clause *reason);
   int probe_dominator (int a, int b);
   int hyper_binary_resolve (Clause *);
+  void probe_propagate_bin_edge (int lit, const BinEdge &);
   void probe_propagate2 ();
   bool probe_propagate ();
   bool is_binary_clause (Clause *c, int &, int &);
   void generate_probes ();
   void flush_probes ();
   int next_probe ();
+  int probe_tree_root (int probe, Clause *&edge);
+  bool probe_tree_leaf (int lit);
+  bool probe_tree_probe (int probe, int root, Clause *edge);
+  void probe_tree (int probe, int64_t limit);
   bool probe_round ();
   void probe (bool update_limits = true);
 
@@ -1082,6 +1129,14 @@ struct Internal {
   unsigned walk_break_value (int lit);
   int walk_pick_lit (Walker &, Clause *);
   void walk_flip_lit (Walker &, int lit);
+  void walk_connect_counts (Walker &);
+  void walk_count_true (Walker &);
+  unsigned walk_pick_unsat (Walker &);
+  int walk_pick_counted_lit (Walker &, unsigned);
+  void walk_flip_counted_lit (Walker &, int lit);
+  void walk_start_helpers (Walker &, double size);
+  void walk_helper (Walker &);
+  int64_t walk_stop_helpers (Walker &);
   int walk_round (int64_t limit, bool prev);
   void walk ();
 
@@ -1216,6 +1271,7 @@ struct Internal {
   int most_occurring_literal ();
   int lookahead_probing ();
   int lookahead_next_probe ();
+  void lookahead_score_probes (int &best, int &max_score);
   void lookahead_flush_probes ();
   void lookahead_generate_probes ();
   std::vector<int> lookahead_populate_locc ();
@@ -1246,6 +1302,22 @@ struct Internal {
     return vals[lit];
   }
 
+  // Skip false literals in '[k,end)' eight at a time with the AVX2 kernel
+  // from 'simd.cpp' if available.  The result points to the first literal
+  // which is not false or to a short tail which is left to the scalar loop
+  // of the caller.  Used in the replacement watch search of long clauses.
+  //
+  literal_iterator skip_false_literals (literal_iterator k,
+                                        const_literal_iterator end) const {
+#ifdef HAVE_AVX2
+    if (end - k >= 8 && avx2 && opts.simd)
+      return avx2_skip_false_literals (vals, k, end);
+#else
+    (void) end;
+#endif
+    return k;
+  }
+
   // As 'val' but restricted to the root-level value of a literal.
   // It is not that time critical and also needs to check the decision level
   // of the variable anyhow.
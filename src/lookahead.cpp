@@ -1,5 +1,9 @@
 #include "internal.hpp"
 
+#ifndef NTHREADS
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 struct literal_occ {
@@ -45,6 +49,9 @@ int Internal::lookahead_locc (const std::vector<int> &loccs) {
 // slow to be called iteratively. A faster (but inexact) version is
 // lookahead_populate_loc and lookahead_loc.
 int Internal::most_occurring_literal () {
+  if (unsat)
+    return INT_MIN;
+
   init_noccs ();
   for (const auto &c : clauses)
     if (!c->redundant)
@@ -54,9 +61,6 @@ int Internal::most_occurring_literal () {
   int64_t max_noccs = 0;
   int res = 0;
 
-  if (unsat)
-    return INT_MIN;
-
   propagate ();
   for (int idx = 1; idx <= max_var; idx++) {
     if (!active (idx) || assumed (idx) || assumed (-idx) || val (idx))
@@ -274,6 +278,289 @@ bool Internal::terminating_asked () {
   return false;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Scoring probes is embarrassingly parallel as long as the clause database
+// does not change.  Thus we take a read-only snapshot of the root-level
+// simplified clauses, binary clauses as implication lists and larger
+// clauses in a flat literal array with occurrence lists, and let each
+// thread propagate probes on its own assignment.  Larger clauses are
+// propagated by counting falsified literals, which avoids moving watches.
+
+static inline unsigned lookahead_vlit (int lit) {
+  return 2u * (unsigned) abs (lit) + (lit < 0);
+}
+
+// Compressed table of lists indexed by 'vlit', filled in two passes.
+
+template <typename T> struct LookaheadTable {
+  vector<unsigned> start; // list of 'v' is 'data[start[v]..start[v+1]]'
+  vector<T> data;
+  void init (size_t size) { start.assign (size + 1, 0); }
+  void count (unsigned v) { start[v + 1]++; }
+  void allocate () {
+    for (size_t v = 1; v < start.size (); v++)
+      start[v] += start[v - 1];
+    data.resize (start.back ());
+  }
+  void push (vector<unsigned> &pos, unsigned v, T t) { data[pos[v]++] = t; }
+  const T *begin (unsigned v) const { return data.data () + start[v]; }
+  const T *end (unsigned v) const { return data.data () + start[v + 1]; }
+};
+
+struct LookaheadSnapshot {
+  vector<signed char> root;        // root-level values by 'vlit'
+  LookaheadTable<int> bins;        // implied literals by 'vlit'
+  LookaheadTable<unsigned> occs;   // large clauses by 'vlit'
+  vector<unsigned> start;          // clause 'c' is 'lits[start[c]..]'
+  vector<int> lits;
+  size_t fixed;                    // root-level trail size
+  LookaheadSnapshot (Internal *);
+};
+
+LookaheadSnapshot::LookaheadSnapshot (Internal *internal)
+    : fixed (internal->trail.size ()) {
+  const size_t size = 2 * (size_t) internal->max_var + 2;
+  root.resize (size);
+  for (int idx = 1; idx <= internal->max_var; idx++) {
+    const signed char tmp = internal->val (idx);
+    root[lookahead_vlit (idx)] = tmp;
+    root[lookahead_vlit (-idx)] = -tmp;
+  }
+
+  // First copy root-level simplified clauses and count occurrences.
+
+  vector<int> binary;
+  bins.init (size);
+  occs.init (size);
+  for (const auto &c : internal->clauses) {
+    if (c->garbage)
+      continue;
+    const size_t old = lits.size ();
+    bool satisfied = false;
+    for (const auto &lit : *c) {
+      const signed char tmp = root[lookahead_vlit (lit)];
+      if (tmp > 0) {
+        satisfied = true;
+        break;
+      }
+      if (!tmp)
+        lits.push_back (lit);
+    }
+    const size_t new_size = lits.size () - old;
+    if (satisfied || new_size < 2)
+      lits.resize (old);
+    else if (new_size == 2) {
+      for (int i = 0; i < 2; i++) {
+        binary.push_back (lits[old + i]);
+        bins.count (lookahead_vlit (-lits[old + i]));
+      }
+      lits.resize (old);
+    } else {
+      start.push_back (old);
+      for (size_t i = old; i < lits.size (); i++)
+        occs.count (lookahead_vlit (lits[i]));
+    }
+  }
+  start.push_back (lits.size ());
+
+  // Then fill the tables.
+
+  bins.allocate ();
+  occs.allocate ();
+  vector<unsigned> pos (bins.start.begin (), bins.start.end () - 1);
+  for (size_t i = 0; i < binary.size (); i += 2) {
+    bins.push (pos, lookahead_vlit (-binary[i]), binary[i + 1]);
+    bins.push (pos, lookahead_vlit (-binary[i + 1]), binary[i]);
+  }
+  pos.assign (occs.start.begin (), occs.start.end () - 1);
+  for (unsigned c = 0; c + 1 < start.size (); c++)
+    for (unsigned i = start[c]; i < start[c + 1]; i++)
+      occs.push (pos, lookahead_vlit (lits[i]), c);
+}
+
+struct LookaheadScorer {
+  const LookaheadSnapshot &snapshot;
+  vector<signed char> vals;
+  vector<unsigned> falsified; // number of falsified literals per clause
+  vector<unsigned> touched;   // clauses with non-zero 'falsified'
+  vector<int> trail;
+
+  LookaheadScorer (const LookaheadSnapshot &s)
+      : snapshot (s), vals (s.root), falsified (s.start.size ()) {}
+
+  bool assign (int lit) {
+    signed char &tmp = vals[lookahead_vlit (lit)];
+    if (tmp)
+      return tmp > 0;
+    tmp = 1;
+    vals[lookahead_vlit (-lit)] = -1;
+    trail.push_back (lit);
+    return true;
+  }
+
+  bool propagate (int lit);
+  int score (int probe);
+};
+
+bool LookaheadScorer::propagate (int lit) {
+  const unsigned pos = lookahead_vlit (lit), neg = lookahead_vlit (-lit);
+  const int *const end_bins = snapshot.bins.end (pos);
+  for (const int *p = snapshot.bins.begin (pos); p != end_bins; p++)
+    if (!assign (*p))
+      return false;
+  const unsigned *const end_occs = snapshot.occs.end (neg);
+  for (const unsigned *p = snapshot.occs.begin (neg); p != end_occs; p++) {
+    const unsigned c = *p;
+    if (!falsified[c]++)
+      touched.push_back (c);
+    const unsigned begin = snapshot.start[c], end = snapshot.start[c + 1];
+    const unsigned size = end - begin;
+    if (falsified[c] == size)
+      return false;
+    if (falsified[c] + 1 < size)
+      continue;
+    int unit = 0;
+    for (unsigned i = begin; i < end; i++) {
+      const int other = snapshot.lits[i];
+      const signed char tmp = vals[lookahead_vlit (other)];
+      if (tmp > 0) {
+        unit = 0;
+        break;
+      }
+      if (!tmp)
+        unit = other;
+    }
+    if (unit)
+      assign (unit);
+  }
+  return true;
+}
+
+// Returns the number of root-level and implied literals after assigning
+// 'probe' (which matches the trail size used as score in sequential
+// probing) or '-1' if 'probe' is a failed literal.
+
+int LookaheadScorer::score (int probe) {
+  assert (!vals[lookahead_vlit (probe)]);
+  assign (probe);
+  bool ok = true;
+  for (size_t i = 0; ok && i < trail.size (); i++)
+    ok = propagate (trail[i]);
+  const int res = ok ? (int) (snapshot.fixed + trail.size ()) : -1;
+  for (const auto &lit : trail)
+    vals[lookahead_vlit (lit)] = vals[lookahead_vlit (-lit)] = 0;
+  for (const auto &c : touched)
+    falsified[c] = 0;
+  trail.clear ();
+  touched.clear ();
+  return res;
+}
+
+// Score all remaining probes on a snapshot with 'lookaheadjobs' threads,
+// where the calling thread is one of them.  Then failed literals are
+// learned in the original order with the sequential 'failed_literal' in
+// order to produce proper proof chains, before the best probe among the
+// remaining ones is selected.  The result is independent of the number
+// of threads.  As for 'walkjobs' only the calling thread is used by
+// default, since library users (and in particular the portfolio workers)
+// should not get additional threads without asking for them.
+
+void Internal::lookahead_score_probes (int &best, int &max_score) {
+
+  if (unsat)
+    return;
+
+  // Same filter as in 'lookahead_next_probe' but only one round.
+  //
+  if (probes.empty ())
+    lookahead_generate_probes ();
+  vector<int> candidates;
+  while (!probes.empty ()) {
+    const int probe = probes.back ();
+    probes.pop_back ();
+    if (!active (probe) || assumed (probe) || assumed (-probe))
+      continue;
+    if (propfixed (probe) >= stats.all.fixed)
+      continue;
+    candidates.push_back (probe);
+  }
+  if (candidates.empty ())
+    return;
+
+  LookaheadSnapshot snapshot (this);
+  const size_t size = candidates.size ();
+  vector<int> scores (size, 0); // '0' if not scored due to termination
+  std::atomic<size_t> next (0);
+  std::atomic<bool> stop (false);
+
+  auto work = [&] (bool primary) {
+    LookaheadScorer scorer (snapshot);
+    for (size_t scored = 0; !stop.load (std::memory_order_relaxed);
+         scored++) {
+      if (primary && !(scored & 63) && terminating_asked ()) {
+        stop = true;
+        break;
+      }
+      const size_t i = next.fetch_add (1, std::memory_order_relaxed);
+      if (i >= size)
+        break;
+      scores[i] = scorer.score (candidates[i]);
+    }
+  };
+
+  size_t jobs = 1;
+#ifndef NTHREADS
+  jobs = opts.lookaheadjobs ? opts.lookaheadjobs
+                            : std::thread::hardware_concurrency ();
+  if (!jobs)
+    jobs = 1;
+  if (jobs > size)
+    jobs = size;
+#endif
+  MSG ("scoring %zu lookahead probes with %zu threads", size, jobs);
+#ifndef NTHREADS
+  vector<std::thread> threads;
+  for (size_t i = 1; i < jobs; i++)
+    threads.push_back (std::thread (work, false));
+#endif
+  work (true);
+#ifndef NTHREADS
+  for (auto &thread : threads)
+    thread.join ();
+#endif
+
+  set_mode (PROBE);
+  init_probehbr_lrat ();
+  for (size_t i = 0; !unsat && i < size; i++) {
+    const int probe = candidates[i];
+    if (scores[i] >= 0 || val (probe))
+      continue;
+    probe_assign_decision (probe);
+    if (probe_propagate ())
+      backtrack ();
+    else
+      failed_literal (probe);
+    clean_probehbr_lrat ();
+  }
+  reset_mode (PROBE);
+
+  for (size_t i = 0; !unsat && i < size; i++) {
+    const int probe = candidates[i];
+    const int score = scores[i];
+    if (!score)
+      continue;
+    stats.probed++;
+    if (score < 0 || !active (probe))
+      continue;
+    if (max_score < score ||
+        (max_score == score && bumped (probe) > bumped (best))) {
+      best = probe;
+      max_score = score;
+    }
+  }
+}
+
 // We run probing on all literals with some differences:
 //
 // * no limit on the number of propagations. We rely on terminating to
@@ -342,32 +629,35 @@ int Internal::lookahead_probing () {
   int res = most_occurring_literal ();
   int max_hbrs = -1;
 
-  set_mode (PROBE);
-
   MSG ("unsat = %d, terminating_asked () = %d ", unsat,
        terminating_asked ());
-  init_probehbr_lrat ();
-  while (!unsat && !terminating_asked () &&
-         (probe = lookahead_next_probe ())) {
-    stats.probed++;
-    int hbrs;
 
-    probe_assign_decision (probe);
-    if (probe_propagate ())
-      hbrs = trail.size (), backtrack ();
-    else
-      hbrs = 0, failed_literal (probe);
-    clean_probehbr_lrat ();
-    if (max_hbrs < hbrs ||
-        (max_hbrs == hbrs &&
-         internal->bumped (probe) > internal->bumped (res))) {
-      res = probe;
-      max_hbrs = hbrs;
+  if (opts.lookaheadpar)
+    lookahead_score_probes (res, max_hbrs);
+  else {
+    set_mode (PROBE);
+    init_probehbr_lrat ();
+    while (!unsat && !terminating_asked () &&
+           (probe = lookahead_next_probe ())) {
+      stats.probed++;
+      int hbrs;
+
+      probe_assign_decision (probe);
+      if (probe_propagate ())
+        hbrs = trail.size (), backtrack ();
+      else
+        hbrs = 0, failed_literal (probe);
+      clean_probehbr_lrat ();
+      if (max_hbrs < hbrs ||
+          (max_hbrs == hbrs &&
+           internal->bumped (probe) > internal->bumped (res))) {
+        res = probe;
+        max_hbrs = hbrs;
+      }
     }
+    reset_mode (PROBE);
   }
 
-  reset_mode (PROBE);
-
   if (unsat) {
     MSG ("probing derived empty clause");
     res = INT_MIN;
@@ -396,7 +686,7 @@ int Internal::lookahead_probing () {
     PHASE ("lookahead-probe-round", stats.probingrounds,
            "found %" PRId64 " hyper binary resolvents", hbrs);
 
-  MSG ("lookahead literal %d with %d\n", res, max_hbrs);
+  MSG ("lookahead literal %d with %d", res, max_hbrs);
 
   return res;
 }
@@ -427,23 +717,22 @@ CubesWithStatus Internal::generate_cubes (int depth, int min_depth) {
     MSG ("Solved during preprocessing");
     CubesWithStatus cubes;
     cubes.status = res;
-    cubes.status = 20;
     lookingahead = false;
     STOP (lookahead);
     return cubes;
   }
 
   reset_limits ();
-  MSG ("generate cubes with %zu assumptions\n", assumptions.size ());
+  MSG ("generate cubes with %zu assumptions", assumptions.size ());
 
   assert (ntab.empty ());
   std::vector<int> current_assumptions{assumptions};
   std::vector<std::vector<int>> cubes{{assumptions}};
   auto loccs{lookahead_populate_locc ()};
-  LOG ("loccs populated\n");
+  LOG ("loccs populated");
   assert (ntab.empty ());
 
-  for (int i = 0; i < depth; ++i) {
+  for (int i = 0; !unsat && i < depth; ++i) {
     LOG ("Probing at depth %i, currently %zu have been generated", i,
          cubes.size ());
     std::vector<std::vector<int>> cubes2{std::move (cubes)};
@@ -459,18 +748,20 @@ CubesWithStatus Internal::generate_cubes (int depth, int min_depth) {
       propagate ();
       // preprocess_round(0); //uncomment maybe
 
+      // Assumptions are only assigned during search and thus the empty
+      // clause derived on the root-level here is not specific to the
+      // current cube but the whole formula is unsatisfiable.
+      //
       if (unsat) {
-        LOG ("current cube is unsat; skipping");
-        unsat = false;
-        continue;
+        LOG ("formula unsatisfiable while splitting cube");
+        break;
       }
 
       int res = terminating_asked () ? lookahead_locc (loccs)
                                      : lookahead_probing ();
       if (unsat) {
-        LOG ("current cube is unsat; skipping");
-        unsat = false;
-        continue;
+        LOG ("formula unsatisfiable while probing cube");
+        break;
       }
 
       if (res == 0) {
@@ -508,7 +799,6 @@ CubesWithStatus Internal::generate_cubes (int depth, int min_depth) {
     LOG ("Solved during preprocessing");
     CubesWithStatus cubes;
     cubes.status = 20;
-    cubes.status = res;
     return cubes;
   }
 
@@ -1,5 +1,12 @@
 #include "internal.hpp"
 
+#ifndef NTHREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
@@ -25,15 +32,50 @@ signed char &LratChecker::checked_lit (int lit) {
   return checked_lits[u];
 }
 
+// Instead of clearing all 'checked_lits' before each check, which is
+// linear in the number of variables, we remember the literals set.
+
+inline void LratChecker::check_lit (int lit) {
+  signed char &b = checked_lit (lit);
+  if (b)
+    return;
+  b = true;
+  checked.push_back (lit);
+}
+
+void LratChecker::clear_checked () {
+  for (const auto &lit : checked)
+    checked_lit (lit) = false;
+  checked.clear ();
+}
+
 /*------------------------------------------------------------------------*/
 
+size_t LratChecker::bytes (unsigned size) {
+  size_t res = sizeof (LratCheckerClause);
+  if (size > 1)
+    res += (size - 1) * sizeof (int);
+  const size_t align = alignof (LratCheckerClause);
+  return (res + align - 1) & ~(align - 1);
+}
+
+char *LratChecker::allocate (size_t bytes) {
+  if ((size_t) (arena_end - arena_top) < bytes) {
+    const size_t size = max (bytes, (size_t) 1 << 20);
+    char *chunk = new char[size];
+    chunks.push_back (chunk);
+    arena_top = chunk;
+    arena_end = chunk + size;
+  }
+  char *res = arena_top;
+  arena_top += bytes;
+  return res;
+}
+
 LratCheckerClause *LratChecker::new_clause () {
   const size_t size = imported_clause.size ();
   assert (size <= UINT_MAX);
-  const int off = size ? -1 : 0;
-  const size_t bytes =
-      sizeof (LratCheckerClause) + (size - off) * sizeof (int);
-  LratCheckerClause *res = (LratCheckerClause *) new char[bytes];
+  LratCheckerClause *res = (LratCheckerClause *) allocate (bytes (size));
   res->garbage = false;
   res->next = 0;
   res->hash = last_hash;
@@ -42,8 +84,6 @@ LratCheckerClause *LratChecker::new_clause () {
   res->used = false;
   res->tautological = false;
   int *literals = res->literals, *p = literals;
-  for (auto &b : checked_lits)
-    b = false;
   for (const auto &lit : imported_clause) {
     *p++ = lit;
     checked_lit (-lit) = true;
@@ -68,7 +108,6 @@ void LratChecker::delete_clause (LratCheckerClause *c) {
     assert (num_garbage);
     num_garbage--;
   }
-  delete[](char *) c;
 }
 
 void LratChecker::enlarge_clauses () {
@@ -93,8 +132,9 @@ void LratChecker::enlarge_clauses () {
   size_clauses = new_size_clauses;
 }
 
-// Probably not necessary since we have no watches.
-//
+// Garbage clauses are dropped by moving all remaining clauses to fresh
+// chunks (in hash table order) and then releasing the old chunks.
+
 void LratChecker::collect_garbage_clauses () {
 
   stats.collections++;
@@ -107,14 +147,126 @@ void LratChecker::collect_garbage_clauses () {
 
   assert (!num_garbage);
   garbage = 0;
+
+  vector<char *> old;
+  old.swap (chunks);
+  arena_top = arena_end = 0;
+  for (uint64_t i = 0; i < size_clauses; i++) {
+    LratCheckerClause **p = clauses + i;
+    for (LratCheckerClause *c = *p; c; c = c->next) {
+      const size_t n = bytes (c->size);
+      LratCheckerClause *d = (LratCheckerClause *) allocate (n);
+      memcpy (d, c, n);
+      *p = d;
+      p = &d->next;
+    }
+  }
+  for (const auto &chunk : old)
+    delete[] chunk;
 }
 
 /*------------------------------------------------------------------------*/
 
+#ifndef NTHREADS
+
+// Single producer single consumer ring buffer of proof steps.  The solver
+// thread only waits if the checker falls behind by the full capacity of
+// the ring (or in 'wait' until the checker caught up) and the checking
+// thread waits for new steps.  Both sides first poll a few rounds and then
+// block on a condition variable, thus an idle side does not burn a core.
+// A blocked side announces itself in 'waiting_checker' respectively
+// 'waiting_solver' before checking its condition again under the lock,
+// while the other side only takes the lock to notify if that flag is set
+// after updating its index.  Since all these accesses are sequentially
+// consistent no wake-up is lost.
+
+struct LratCheckerQueue {
+  struct Step {
+    char type;
+    uint64_t id;
+    vector<int> clause;
+    vector<uint64_t> chain;
+  };
+  static const uint64_t capacity = 1u << 12;
+  static const unsigned spins = 100;
+  Step steps[capacity];
+  std::atomic<uint64_t> head, tail;
+  std::atomic<bool> stop;
+  std::atomic<bool> waiting_checker, waiting_solver;
+  std::mutex mutex;
+  std::condition_variable filled, drained;
+  LratChecker *checker;
+  std::thread thread;
+  LratCheckerQueue (LratChecker *c)
+      : head (0), tail (0), stop (false), waiting_checker (false),
+        waiting_solver (false), checker (c),
+        thread (&LratCheckerQueue::run, this) {}
+  ~LratCheckerQueue () {
+    stop = true;
+    wake (waiting_checker, filled);
+    thread.join ();
+  }
+  template <class Ready>
+  void block (Ready ready, std::atomic<bool> &waiting,
+              std::condition_variable &condition) {
+    for (unsigned i = 0; i < spins; i++) {
+      if (ready ())
+        return;
+      std::this_thread::yield ();
+    }
+    std::unique_lock<std::mutex> lock (mutex);
+    waiting = true;
+    condition.wait (lock, ready);
+    waiting = false;
+  }
+  void wake (std::atomic<bool> &waiting,
+             std::condition_variable &condition) {
+    if (!waiting)
+      return;
+    std::lock_guard<std::mutex> lock (mutex);
+    condition.notify_one ();
+  }
+  void push (char type, uint64_t id, const vector<int> &clause,
+             const vector<uint64_t> &chain) {
+    const uint64_t h = head.load (std::memory_order_relaxed);
+    block ([this, h] () { return h - tail < capacity; }, waiting_solver,
+           drained);
+    Step &step = steps[h % capacity];
+    step.type = type;
+    step.id = id;
+    step.clause = clause;
+    step.chain = chain;
+    head = h + 1;
+    wake (waiting_checker, filled);
+  }
+  void wait () {
+    const uint64_t h = head.load (std::memory_order_relaxed);
+    block ([this, h] () { return tail == h; }, waiting_solver, drained);
+  }
+  void run () {
+    for (;;) {
+      const uint64_t t = tail.load (std::memory_order_relaxed);
+      block ([this, t] () { return head != t || stop; }, waiting_checker,
+             filled);
+      if (head == t)
+        break;
+      Step &step = steps[t % capacity];
+      checker->process (step.type, step.id, step.clause, step.chain);
+      tail = t + 1;
+      wake (waiting_solver, drained);
+    }
+  }
+};
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 LratChecker::LratChecker (Internal *i)
     : internal (i), size_vars (0), num_clauses (0), num_finalized (0),
       num_garbage (0), size_clauses (0), clauses (0), garbage (0),
-      last_hash (0), last_id (0) {
+      arena_top (0), arena_end (0), last_hash (0), last_id (0),
+      queue (0) {
   LOG ("LRAT CHECKER new");
 
   // Initialize random number table for hash function.
@@ -129,17 +281,25 @@ LratChecker::LratChecker (Internal *i)
   }
 
   strict_lrat = internal->opts.lrat;
+  lratexternal = internal->opts.lratexternal;
 
   memset (&stats, 0, sizeof (stats)); // Initialize statistics.
+
+#ifndef NTHREADS
+  if (internal->opts.checkproofthread) {
+    LOG ("LRAT CHECKER checking in separate thread");
+    queue = new LratCheckerQueue (this);
+  }
+#endif
 }
 
 LratChecker::~LratChecker () {
   LOG ("LRAT CHECKER delete");
-  for (size_t i = 0; i < size_clauses; i++)
-    for (LratCheckerClause *c = clauses[i], *next; c; c = next)
-      next = c->next, delete_clause (c);
-  for (LratCheckerClause *c = garbage, *next; c; c = next)
-    next = c->next, delete_clause (c);
+#ifndef NTHREADS
+  delete queue;
+#endif
+  for (const auto &chunk : chunks)
+    delete[] chunk;
   delete[] clauses;
 }
 
@@ -226,81 +386,86 @@ void LratChecker::insert () {
 /*------------------------------------------------------------------------*/
 
 // TODO "strict" resolution check instead of rup check
-bool LratChecker::check_resolution (vector<uint64_t> proof_chain) {
+bool LratChecker::check_resolution (const vector<uint64_t> &proof_chain) {
   if (proof_chain.empty ()) { // ignore these case TODO chain.size == 1?
     LOG ("LRAT CHECKER resolution check skipped clause is tautological");
     return true;
   }
-  if (internal->opts.lratexternal) { // ignore this case
+  if (lratexternal) { // ignore this case
     LOG ("LRAT CHECKER resolution check skipped because "
          "opts.lratexternal=true");
     return true;
   }
   LOG (imported_clause, "LRAT CHECKER checking clause with resolution");
-  for (auto &b : checked_lits)
-    b = false; // clearing checking bits
+  assert (checked.empty ());
   LratCheckerClause *c = *find (proof_chain.back ());
   assert (c);
   for (int *i = c->literals; i < c->literals + c->size; i++) {
     int lit = *i;
-    checked_lit (lit) = true;
+    check_lit (lit);
     assert (!checked_lit (-lit));
   }
-  for (auto p = proof_chain.end () - 2; p >= proof_chain.begin (); p--) {
-    auto &id = *p;
+  for (size_t j = proof_chain.size () - 1; j-- > 0;) {
+    const auto &id = proof_chain[j];
     c = *find (id);
     assert (c); // since this is checked in check already
     for (int *i = c->literals; i < c->literals + c->size; i++) {
       int lit = *i;
       if (!checked_lit (-lit))
-        checked_lit (lit) = true;
+        check_lit (lit);
       else
         checked_lit (-lit) = false;
     }
   }
+  bool res = true;
   for (const auto &lit : imported_clause) {
     if (checked_lit (-lit)) {
       LOG ("LRAT CHECKER resolution failed, resolved literal %d in learned "
            "clause",
            lit);
-      return false;
+      res = false;
+      break;
     }
     if (!checked_lit (lit)) {
       // learned clause is subsumed by resolvents
       // assert (internal->opts.instantiate || internal->opts.decompose);
-      checked_lit (lit) = true;
+      check_lit (lit);
     }
-    checked_lit (-lit) = true;
+    check_lit (-lit);
   }
-  for (int64_t lit = 1; lit < size_vars; lit++) {
-    bool ok = checked_lit (lit) && checked_lit (-lit);
-    ok = ok || (!checked_lit (lit) && !checked_lit (-lit));
+  // Only variables of literals set above can be set at all.
+  //
+  for (size_t j = 0; res && j < checked.size (); j++) {
+    const int idx = abs (checked[j]);
+    bool ok = checked_lit (idx) && checked_lit (-idx);
+    ok = ok || (!checked_lit (idx) && !checked_lit (-idx));
     if (!ok) {
       LOG ("LRAT CHECKER resolution failed, learned clause does not match "
            "on "
-           "variable %" PRId64,
-           lit);
-      return false;
+           "variable %d",
+           idx);
+      res = false;
     }
   }
+  clear_checked ();
 
-  return true;
+  return res;
 }
 
 /*------------------------------------------------------------------------*/
 
-bool LratChecker::check (vector<uint64_t> proof_chain) {
+bool LratChecker::check (const vector<uint64_t> &proof_chain) {
   LOG (imported_clause, "LRAT CHECKER checking clause");
   stats.checks++;
   // assert (proof_chain.size ());             // this might be attempting
   // to
-  for (auto &b : checked_lits)
-    b = false;                              // assert here but fails for
+  assert (checked.empty ());                // assert here but fails for
   for (const auto &lit : imported_clause) { // tautological clauses
-    checked_lit (-lit) = true;
+    check_lit (-lit);
     if (checked_lit (lit)) {
       LOG (imported_clause, "LRAT CHECKER clause tautological");
       assert (!proof_chain.size ()); // would be unnecessary hence a bug
+      clear_checked ();
       return true;
     }
   }
@@ -350,11 +515,12 @@ bool LratChecker::check (vector<uint64_t> proof_chain) {
       break;
     }
     LOG ("LRAT CHECKER found unit clause %" PRIu64 ", assign %d", id, unit);
-    checked_lit (unit) = true;
+    check_lit (unit);
   }
   for (auto &lc : used_clauses) {
     lc->used = false;
   }
+  clear_checked ();
   if (!checking) {
     LOG ("LRAT CHECKER failed, no conflict found");
     return false; // check failed because no empty clause was found
@@ -364,8 +530,7 @@ bool LratChecker::check (vector<uint64_t> proof_chain) {
 
 /*------------------------------------------------------------------------*/
 
-void LratChecker::add_original_clause (uint64_t id, const vector<int> &c) {
-  START (checking);
+void LratChecker::original (uint64_t id, const vector<int> &c) {
   LOG (c, "LRAT CHECKER addition of original clause[%" PRIu64 "]", id);
   stats.added++;
   stats.original++;
@@ -374,12 +539,10 @@ void LratChecker::add_original_clause (uint64_t id, const vector<int> &c) {
   assert (id);
   insert ();
   imported_clause.clear ();
-  STOP (checking);
 }
 
-void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c,
-                                      const vector<uint64_t> &proof_chain) {
-  START (checking);
+void LratChecker::derived (uint64_t id, const vector<int> &c,
+                           const vector<uint64_t> &proof_chain) {
   LOG (c, "LRAT CHECKER addition of derived clause[%" PRIu64 "]", id);
   stats.added++;
   stats.derived++;
@@ -396,11 +559,9 @@ void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c,
   } else
     insert ();
   imported_clause.clear ();
-  STOP (checking);
 }
 
-void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c) {
-  START (checking);
+void LratChecker::unproven (uint64_t id, const vector<int> &c) {
   LOG (c, "LRAT CHECKER checking derived unproven clause[%" PRIu64 "]", id);
   stats.added++;
   import_clause (c);
@@ -416,13 +577,11 @@ void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c) {
   } else
     insert ();
   imported_clause.clear ();
-  STOP (checking);
 }
 
 /*------------------------------------------------------------------------*/
 
-void LratChecker::delete_clause (uint64_t id, const vector<int> &c) {
-  START (checking);
+void LratChecker::remove (uint64_t id, const vector<int> &c) {
   LOG (c, "LRAT CHECKER checking deletion of clause[%" PRIu64 "]", id);
   stats.deleted++;
   import_clause (c);
@@ -469,11 +628,9 @@ void LratChecker::delete_clause (uint64_t id, const vector<int> &c) {
     fatal_message_end ();
   }
   imported_clause.clear ();
-  STOP (checking);
 }
 
-void LratChecker::finalize_clause (uint64_t id, const vector<int> &c) {
-  START (checking);
+void LratChecker::finalize (uint64_t id, const vector<int> &c) {
   LOG (c, "LRAT CHECKER checking finalize of clause[%" PRIu64 "]", id);
   stats.finalized++;
   num_finalized++;
@@ -507,12 +664,79 @@ void LratChecker::finalize_clause (uint64_t id, const vector<int> &c) {
     fatal_message_end ();
   }
   imported_clause.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
+// The public functions either check the proof step immediately or pass it
+// on to the checking thread.
+
+void LratChecker::process (char type, uint64_t id, const vector<int> &c,
+                           const vector<uint64_t> &proof_chain) {
+  switch (type) {
+  case 'o':
+    original (id, c);
+    break;
+  case 'a':
+    derived (id, c, proof_chain);
+    break;
+  case 'u':
+    unproven (id, c);
+    break;
+  case 'd':
+    remove (id, c);
+    break;
+  default:
+    assert (type == 'f');
+    finalize (id, c);
+    break;
+  }
+}
+
+void LratChecker::step (char type, uint64_t id, const vector<int> &c,
+                        const vector<uint64_t> &proof_chain) {
+  START (checking);
+#ifndef NTHREADS
+  if (queue)
+    queue->push (type, id, c, proof_chain);
+  else
+#endif
+    process (type, id, c, proof_chain);
   STOP (checking);
 }
 
+void LratChecker::wait () {
+#ifndef NTHREADS
+  if (queue)
+    queue->wait ();
+#endif
+}
+
+void LratChecker::add_original_clause (uint64_t id, const vector<int> &c) {
+  step ('o', id, c, vector<uint64_t> ());
+}
+
+void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c,
+                                      const vector<uint64_t> &proof_chain) {
+  step ('a', id, c, proof_chain);
+}
+
+void LratChecker::add_derived_clause (uint64_t id, const vector<int> &c) {
+  step ('u', id, c, vector<uint64_t> ());
+}
+
+void LratChecker::delete_clause (uint64_t id, const vector<int> &c) {
+  step ('d', id, c, vector<uint64_t> ());
+}
+
+void LratChecker::finalize_clause (uint64_t id, const vector<int> &c) {
+  step ('f', id, c, vector<uint64_t> ());
+}
+
 // check if all clauses have been deleted
 void LratChecker::finalize_check () {
   START (checking);
+  wait ();
   if (num_finalized == num_clauses) {
     num_finalized = 0;
     LOG ("LRAT CHECKER successful finalize check, all clauses have been "
@@ -530,6 +754,7 @@ void LratChecker::finalize_check () {
 /*------------------------------------------------------------------------*/
 
 void LratChecker::dump () {
+  wait ();
   int max_var = 0;
   for (uint64_t i = 0; i < size_clauses; i++)
     for (LratCheckerClause *c = clauses[i]; c; c = c->next)
@@ -16,6 +16,8 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
+struct LratCheckerQueue;
+
 struct LratCheckerClause {
   LratCheckerClause *next; // collision chain link for hash table
   uint64_t hash;           // previously computed full 64-bit hash
@@ -48,6 +50,10 @@ class LratChecker {
 
   vector<signed char> checked_lits;
   vector<signed char> marks; // mark bits of literals
+  vector<int> checked;       // literals with 'checked_lit' set
+
+  void check_lit (int lit); // set 'checked_lit' and remember it
+  void clear_checked ();    // reset all 'checked_lit' to false
 
   uint64_t num_clauses; // number of clauses in hash table
   uint64_t num_finalized;
@@ -58,6 +64,15 @@ class LratChecker {
 
   vector<int> imported_clause; // original clause for reporting
 
+  // Clauses are allocated in large chunks of memory and thus their
+  // literals are stored contiguously.  Garbage clauses are not freed
+  // individually but compacted away during garbage collection.
+  //
+  vector<char *> chunks;
+  char *arena_top, *arena_end;
+  static size_t bytes (unsigned size);
+  char *allocate (size_t bytes);
+
   void enlarge_vars (int64_t idx);
   void import_literal (int lit);
   void import_clause (const vector<int> &);
@@ -85,9 +100,30 @@ class LratChecker {
   LratCheckerClause *new_clause ();
   void delete_clause (LratCheckerClause *);
 
-  bool check (vector<uint64_t>); // check if new clause is implied by rup
-  bool check_resolution (
-      vector<uint64_t>); // check if new clause is implied by resolution
+  // check if new clause is implied by rup
+  bool check (const vector<uint64_t> &);
+  // check if new clause is implied by resolution
+  bool check_resolution (const vector<uint64_t> &);
+
+  bool lratexternal; // skip resolution checks for external chains
+
+  // Optionally the actual checking is performed by a separate thread,
+  // which gets the proof steps from a (lock-free) single producer single
+  // consumer queue.  The public functions only put steps on this queue.
+  //
+  LratCheckerQueue *queue;
+  friend struct LratCheckerQueue;
+  void process (char type, uint64_t, const vector<int> &,
+                const vector<uint64_t> &);
+  void step (char type, uint64_t, const vector<int> &,
+             const vector<uint64_t> &);
+  void wait ();
+
+  void original (uint64_t, const vector<int> &);
+  void derived (uint64_t, const vector<int> &, const vector<uint64_t> &);
+  void unproven (uint64_t, const vector<int> &);
+  void remove (uint64_t, const vector<int> &);
+  void finalize (uint64_t, const vector<int> &);
 
   struct {
 
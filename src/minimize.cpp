@@ -23,6 +23,8 @@ bool Internal::minimize_literal (int lit, int depth) {
     return true;
   if (!v.reason || f.poison || v.level == level)
     return false;
+  if (v.reason == external_reason)
+    return false; // not explained (see 'explain_external_propagations')
   const Level &l = control[v.level];
   if (!depth && l.seen.count < 2)
     return false; // Don Knuth's idea
@@ -250,10 +250,11 @@ private:
   std::map<int, size_t> prop_reason_loc;
 
 public:
-  MockPropagator (Solver *solver) {
+  MockPropagator (Solver *solver, bool batched = false) {
     observed_trail.push_back (std::vector<int> ());
     s = solver;
     lemmas_per_queries.push_back (0);
+    is_batched = batched;
   }
 
   ~MockPropagator () {}
@@ -388,6 +389,7 @@ public:
   }
 
   int cb_add_external_clause_lit () {
+    assert (!is_batched);
     assert (lemma_loc < all_external_clauses.size ());
     assert (lemma_lit_loc < all_external_clauses[lemma_loc].size ());
     int lit = all_external_clauses[lemma_loc][lemma_lit_loc++];
@@ -500,6 +502,7 @@ public:
   }
 
   int cb_add_reason_clause_lit (int plit) {
+    assert (!is_batched);
     assert (reason_map.find (plit) != reason_map.end ());
     assert (prop_reason_loc[plit] <
             all_external_clauses[reason_map[plit]].size ());
@@ -512,6 +515,7 @@ public:
   }
 
   void notify_assignment (int lit, bool is_fixed) {
+    assert (!is_batched);
     if (is_fixed) {
       observed_trail.front ().push_back (lit);
     } else {
@@ -519,6 +523,36 @@ public:
     }
   }
 
+  // Batched interface ('connect batched-mock-propagator'), where clauses
+  // are returned as spans of the stored clauses (without their zero).
+
+  void notify_assignments (const int *lits, size_t size, bool is_fixed) {
+    assert (is_batched);
+    auto &level_lits =
+        is_fixed ? observed_trail.front () : observed_trail.back ();
+    level_lits.insert (level_lits.end (), lits, lits + size);
+  }
+
+  size_t cb_add_reason_clause (int plit, const int *&lits) {
+    assert (is_batched);
+    assert (reason_map.find (plit) != reason_map.end ());
+    const auto &reason = all_external_clauses[reason_map[plit]];
+    assert (!reason.empty () && !reason.back ());
+    lits = reason.data ();
+    return reason.size () - 1;
+  }
+
+  size_t cb_add_external_clause (const int *&lits) {
+    assert (is_batched);
+    assert (lemma_loc < all_external_clauses.size ());
+    assert (!lemma_lit_loc);
+    const auto &lemma = all_external_clauses[lemma_loc++];
+    assert (!lemma.empty () && !lemma.back ());
+    nof_added_clauses++;
+    lits = lemma.data ();
+    return lemma.size () - 1;
+  }
+
   void notify_new_decision_level () {
     observed_trail.push_back (std::vector<int> ());
   }
@@ -984,21 +1018,23 @@ struct ConstrainCall : public Call {
 };
 
 struct ConnectCall : public Call {
-  ConnectCall () : Call (CONNECT) {}
+  ConnectCall (int batched = 0) : Call (CONNECT, batched) {}
   void execute (Solver *&s) {
     // clean up if there was already one mock propagator
     MockPropagator *prev_pointer = 0;
     if (mobical.mock_pointer)
       prev_pointer = mobical.mock_pointer;
 
-    mobical.mock_pointer = new MockPropagator (s);
+    mobical.mock_pointer = new MockPropagator (s, arg);
     s->connect_external_propagator (mobical.mock_pointer);
 
     if (prev_pointer)
       delete prev_pointer;
   }
-  void print (ostream &o) { o << "connect mock-propagator" << endl; }
-  Call *copy () { return new ConnectCall (); }
+  void print (ostream &o) {
+    o << "connect " << (arg ? "batched-" : "") << "mock-propagator" << endl;
+  }
+  Call *copy () { return new ConnectCall (arg); }
   const char *keyword () { return "connect"; }
 };
 
@@ -1782,7 +1818,7 @@ void Trace::generate_propagator (Random &random, int minvars, int maxvars) {
   assert (minvars <= maxvars);
   if (in_connection)
     push_back (new DisconnectCall ());
-  push_back (new ConnectCall ());
+  push_back (new ConnectCall (random.generate_bool ()));
 
   in_connection = true;
 
@@ -3225,7 +3261,14 @@ void Reader::parse () {
       constraining = lit;
       c = new ConstrainCall (lit);
     } else if (!strcmp (keyword, "connect")) {
-      c = new ConnectCall ();
+      if (second)
+        error ("additional argument '%s' to 'connect'", second);
+      if (first && !strcmp (first, "batched-mock-propagator"))
+        c = new ConnectCall (1);
+      else if (!first || !strcmp (first, "mock-propagator"))
+        c = new ConnectCall ();
+      else
+        error ("invalid argument '%s' to 'connect'", first);
     } else if (!strcmp (keyword, "disconnect")) {
       c = new DisconnectCall ();
     } else if (!strcmp (keyword, "observe")) {
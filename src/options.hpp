@@ -22,7 +22,12 @@
 /*      NAME         DEFAULT, LO, HI,O,P,R, USAGE */ \
 \
 OPTION( arena,             1,  0,  1,0,0,1, "allocate clauses in arena") \
+OPTION( arenabinary,       0,  0,  1,0,0,1, "move binary clauses too") \
 OPTION( arenacompact,      1,  0,  1,0,0,1, "keep clauses compact") \
+OPTION( arenagen,          1,  0,  1,0,0,1, "generational arena") \
+OPTION( arenahuge,         0,  0,  1,0,0,1, "huge pages for arena") \
+OPTION( arenahugemin,      4,  0,1e3,0,0,1, "minimum huge arena space in MB") \
+OPTION( arenaold,         25,  0,100,0,0,1, "old space waste limit in percent") \
 OPTION( arenasort,         1,  0,  1,0,0,1, "sort clauses in arena") \
 OPTION( arenatype,         3,  1,  3,0,0,1, "1=clause, 2=var, 3=queue") \
 OPTION( binary,            1,  0,  1,0,0,1, "use binary proof format") \
@@ -40,6 +45,7 @@ OPTION( checkfailed,       1,  0,  1,0,0,0, "check failed literals form core") \
 OPTION( checkfrozen,       0,  0,  1,0,0,0, "check all frozen semantics") \
 OPTION( checkproof,        1,  0,  1,0,0,0, "check proof internally") \
 OPTION( checkprooflrat,    1,  0,  1,0,0,0, "use internal LRAT proof checker") \
+OPTION( checkproofthread,  0,  0,  1,0,0,0, "check LRAT proof in separate thread") \
 OPTION( checkwitness,      1,  0,  1,0,0,0, "check witness internally") \
 OPTION( chrono,            1,  0,  2,0,0,1, "chronological backtracking") \
 OPTION( chronoalways,      0,  0,  1,0,0,1, "force always chronological") \
@@ -79,6 +85,9 @@ OPTION( elimint,         2e3,  1,2e9,0,0,1, "elimination interval") \
 OPTION( elimites,          1,  0,  1,0,0,1, "find if-then-else gates") \
 OPTION( elimlimited,       1,  0,  1,0,0,1, "limit resolutions") \
 OPTION( elimocclim,      1e2,  0,2e9,2,0,1, "occurrence limit") \
+OPTION( elimpar,           0,  0,  1,0,0,1, "eliminate in parallel batches") \
+OPTION( elimparbatch,    1e3,  1,1e6,0,0,1, "candidates per batch") \
+OPTION( elimparjobs,       1,  0,512,0,0,1, "elimination threads (0=cores)") \
 OPTION( elimprod,          1,  0,1e4,0,0,1, "elim score product weight") \
 OPTION( elimreleff,      1e3,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( elimrounds,        2,  1,512,1,0,1, "usual number of rounds") \
@@ -93,6 +102,7 @@ OPTION( emalevel,        1e5,  1,2e9,0,0,1, "window back-track level") \
 OPTION( emasize,         1e5,  1,2e9,0,0,1, "window learned clause size") \
 OPTION( ematrailfast,    1e2,  1,2e9,0,0,1, "window fast trail") \
 OPTION( ematrailslow,    1e5,  1,2e9,0,0,1, "window slow trail") \
+OPTION( explainbound,      1,  0,  1,0,0,1, "explain conflict level only") \
 OPTION( flush,             0,  0,  1,0,0,1, "flush redundant clauses") \
 OPTION( flushfactor,       3,  1,1e3,0,0,1, "interval increase") \
 OPTION( flushint,        1e5,  1,2e9,0,0,1, "initial limit") \
@@ -103,16 +113,22 @@ OPTION( instantiate,       0,  0,  1,0,1,1, "variable instantiation") \
 OPTION( instantiateclslim, 3,  2,2e9,0,0,1, "minimum clause size") \
 OPTION( instantiateocclim, 1,  1,2e9,2,0,1, "maximum occurrence limit") \
 OPTION( instantiateonce,   1,  0,  1,0,0,1, "instantiate each clause once") \
+OPTION( learnbatch,        0,  0,2e9,0,0,1, "batch learner flush interval") \
 LOGOPT( log,               0,  0,  1,0,0,0, "enable logging") \
 LOGOPT( logsort,           0,  0,  1,0,0,0, "sort logged clauses") \
+OPTION( lookaheadjobs,     1,  0,512,0,0,1, "lookahead threads (0=cores)") \
+OPTION( lookaheadpar,      1,  0,  1,0,0,1, "score lookahead in parallel") \
 OPTION( lrat,              0,  0,  1,0,0,1, "use lrat proof format") \
 OPTION( lratexternal,      0,  0,  1,0,0,1, "external lrat") \
 OPTION( lratfrat,          0,  0,  1,0,0,1, "use frat proof format") \
+OPTION( lrattrim,          0,  0,  1,0,0,1, "only write lrat clauses used") \
 OPTION( lratveripb,        0,  0,  1,0,0,1, "veriPB proofs. needs lrat=1") \
 OPTION( lucky,             1,  0,  1,0,0,1, "search for lucky phases") \
 OPTION( minimize,          1,  0,  1,0,0,1, "minimize learned clauses") \
 OPTION( minimizedepth,   1e3,  0,1e3,0,0,1, "minimization depth") \
 OPTION( otfs,              1,  0,  1,0,0,1, "on-the-fly self subsumption") \
+OPTION( parsechunk,     4096,  1,1e6,0,0,1, "parsing chunk size in KB") \
+OPTION( parsejobs,         1,  0,512,0,0,1, "parsing threads (0=cores)") \
 OPTION( phase,             1,  0,  1,0,0,1, "initial phase") \
 OPTION( probe,             1,  0,  1,0,1,1, "failed literal probing" ) \
 OPTION( probehbr,          1,  0,  1,0,0,1, "learn hyper binary clauses") \
@@ -121,7 +137,10 @@ OPTION( probemaxeff,     1e8,  0,2e9,1,0,1, "maximum probing efficiency") \
 OPTION( probemineff,     1e6,  0,2e9,1,0,1, "minimum probing efficiency") \
 OPTION( probereleff,      20,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( proberounds,       1,  1, 16,1,0,1, "probing rounds" ) \
+OPTION( probetree,         1,  0,  1,0,0,1, "share propagation in probe trees") \
 OPTION( profile,           2,  0,  4,0,0,0, "profiling level") \
+OPTION( proofasync,        1,  0,  1,0,0,0, "write proof in background thread") \
+OPTION( proofbuffer,       4,  0,1e3,0,0,0, "proof buffer in MB (0=unbuffered)") \
 QUTOPT( quiet,             0,  0,  1,0,0,0, "disable all messages") \
 OPTION( radixsortlim,    800,  0,2e9,0,0,1, "radix sort limit") \
 OPTION( realtime,          0,  0,  1,0,0,0, "real instead of process time") \
@@ -148,12 +167,16 @@ OPTION( reverse,           0,  0,  1,0,0,1, "reverse variable ordering") \
 OPTION( score,             1,  0,  1,0,0,1, "use EVSIDS scores") \
 OPTION( scorefactor,     950,500,1e3,0,0,1, "score factor per mille") \
 OPTION( seed,              0,  0,2e9,0,0,1, "random seed") \
+OPTION( shareglue,         2,  1,1e9,0,0,1, "maximum glue of shared clauses") \
+OPTION( shareint,        300,  1,1e9,0,0,1, "shared clause import interval") \
+OPTION( sharesize,         8,  2, 16,0,0,1, "maximum size of shared clauses") \
 OPTION( shrink,            3,  0,  3,0,0,1, "shrink conflict clause") \
 OPTION( shrinkreap,        1,  0,  1,0,0,1, "use a reap for shrinking") \
 OPTION( shuffle,           0,  0,  1,0,0,1, "shuffle variables") \
 OPTION( shufflequeue,      1,  0,  1,0,0,1, "shuffle variable queue") \
 OPTION( shufflerandom,     0,  0,  1,0,0,1, "not reverse but random") \
 OPTION( shufflescores,     1,  0,  1,0,0,1, "shuffle variable scores") \
+OPTION( simd,              0,  0,  1,0,0,1, "vectorized clause scanning (AVX2)") \
 OPTION( stabilize,         1,  0,  1,0,0,1, "enable stabilizing phases") \
 OPTION( stabilizefactor, 200,101,2e9,0,0,1, "phase increase in percent") \
 OPTION( stabilizeint,    1e3,  1,2e9,0,0,1, "stabilizing interval") \
@@ -189,9 +212,13 @@ OPTION( vivifyinst,        1,  0,  1,0,0,1, "instantiate last literal when vivif
 OPTION( vivifymaxeff,    2e7,  0,2e9,1,0,1, "maximum efficiency") \
 OPTION( vivifymineff,    2e4,  0,2e9,1,0,1, "minimum efficiency") \
 OPTION( vivifyonce,        0,  0,  2,0,0,1, "vivify once: 1=red, 2=red+irr") \
+OPTION( vivifypar,         0,  0,  1,0,0,1, "check candidates in parallel") \
+OPTION( vivifyparjobs,     1,  0,512,0,0,1, "vivification threads (0=cores)") \
 OPTION( vivifyredeff,     75,  0,1e3,1,0,1, "redundant efficiency per mille") \
 OPTION( vivifyreleff,     20,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( walk,              1,  0,  1,0,0,1, "enable random walks") \
+OPTION( walkcounts,        1,  0,  1,0,0,1, "walk with cached break values") \
+OPTION( walkjobs,          1,  0,512,0,0,1, "walk threads (0=cores)") \
 OPTION( walkmaxeff,      1e7,  0,2e9,1,0,1, "maximum efficiency") \
 OPTION( walkmineff,      1e5,  0,1e7,1,0,1, "minimum efficiency") \
 OPTION( walknonstable,     1,  0,  1,0,0,1, "walk in non-stabilizing phase") \
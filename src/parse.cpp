@@ -1,5 +1,11 @@
 #include "internal.hpp"
 
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -86,6 +92,239 @@ inline const char *Parser::parse_lit (int &ch, int &lit, int &vars,
 
 /*------------------------------------------------------------------------*/
 
+// Fast path for the body of uncompressed DIMACS files.  The file is mapped
+// into memory and split into chunks at line boundaries, which are scanned
+// concurrently into literal vectors.  The clauses are then added in file
+// order by the calling thread, which also scans chunks itself while
+// waiting for the next one.  With 'parsejobs' threads at most twice as
+// many chunks are scanned ahead of the chunk currently added, which bounds
+// the memory needed for the literal vectors independent of the file size.
+// By default only the calling thread scans.  The scanner only accepts
+// what the character based parser above accepts.  If it finds anything
+// else, or if adding a chunk would exceed the number of clauses in the
+// header, we simply continue with the character based parser at the start
+// of that chunk, which then produces the same error message with the right
+// line number.
+
+struct DimacsChunk {
+  const char *begin, *end;
+  vector<int> lits;        // scanned literals including zeros
+  uint64_t lines;          // number of new-lines in the chunk
+  int max_var;             // maximum variable index
+  int clauses;             // number of zeros
+  bool failed;             // scanner found something unusual
+  std::atomic<bool> ready; // scanning finished
+  DimacsChunk ()
+      : begin (0), end (0), lines (0), max_var (0), clauses (0),
+        failed (false), ready (false) {}
+};
+
+static bool scan_dimacs_chunk (DimacsChunk &chunk, int vars, bool forced) {
+  const char *p = chunk.begin, *end = chunk.end;
+  vector<int> &lits = chunk.lits;
+  lits.reserve ((end - p) / 4);
+  while (p != end) {
+    int ch = *p++;
+    if (ch == '\n') {
+      chunk.lines++;
+      continue;
+    }
+    if (ch == ' ' || ch == '\t' || ch == '\r')
+      continue;
+    if (ch == 'c') {
+      while (p != end && *p != '\n')
+        p++;
+      continue;
+    }
+    int sign = 1;
+    if (ch == '-') {
+      if (p == end)
+        return false;
+      ch = *p++;
+      sign = -1;
+    }
+    unsigned digit = (unsigned) (ch - '0');
+    if (digit > 9)
+      return false;
+    int lit = digit;
+    while (p != end && (digit = (unsigned) (*p - '0')) <= 9) {
+      if (INT_MAX / 10 < lit || INT_MAX - (int) digit < 10 * lit)
+        return false;
+      lit = 10 * lit + digit;
+      p++;
+    }
+    if (p != end && *p == '\r')
+      p++;
+    if (p != end) {
+      ch = *p;
+      if (ch == 'c') {
+        while (p != end && *p != '\n')
+          p++;
+        if (p == end)
+          return false; // End-of-file in comment.
+      } else if (ch != ' ' && ch != '\t' && ch != '\n')
+        return false;
+    }
+    if (lit > chunk.max_var) {
+      if (!forced && lit > vars)
+        return false;
+      chunk.max_var = lit;
+    }
+    if (!lit)
+      chunk.clauses++;
+    lits.push_back (sign * lit);
+  }
+  return true;
+}
+
+static void scan_dimacs_chunk_and_flag (DimacsChunk &chunk, int vars,
+                                        bool forced) {
+  chunk.failed = !scan_dimacs_chunk (chunk, vars, forced);
+  chunk.ready.store (true, std::memory_order_release);
+}
+
+const char *Parser::parse_dimacs_mapped (int &lit, int &parsed, int &vars,
+                                         int clauses, int strict) {
+  size_t size, offset;
+  const char *start = file->map (size, offset);
+  if (!start)
+    return 0;
+
+  const size_t chunk_size = (size_t) internal->opts.parsechunk << 10;
+  vector<size_t> bounds;
+  for (size_t pos = offset; pos < size;) {
+    bounds.push_back (pos);
+    if (size - pos <= chunk_size)
+      pos = size;
+    else {
+      pos += chunk_size;
+      const void *nl = memchr (start + pos, '\n', size - pos);
+      pos = nl ? (const char *) nl - start + 1 : size;
+    }
+  }
+  bounds.push_back (size);
+
+  const size_t n = bounds.size () - 1;
+  vector<DimacsChunk> chunks (n);
+  for (size_t i = 0; i < n; i++) {
+    chunks[i].begin = start + bounds[i];
+    chunks[i].end = start + bounds[i + 1];
+  }
+
+  const bool forced = (strict == FORCED);
+
+  size_t jobs = 1;
+#ifndef NTHREADS
+  jobs = internal->opts.parsejobs ? internal->opts.parsejobs
+                                  : std::thread::hardware_concurrency ();
+  if (!jobs)
+    jobs = 1;
+  if (jobs > n)
+    jobs = n;
+#endif
+  const size_t window = 2 * jobs; // chunks scanned ahead at most
+
+  // Claims the next chunk to scan if it is within the window of chunks
+  // after the first one not added yet.  Helper threads wait for the window
+  // to move, while the calling thread does not ('wait = false').  Returns
+  // 'n' if there is nothing to scan (anymore).
+
+  size_t next = 0, added = 0;
+  bool stop = false;
+#ifndef NTHREADS
+  std::mutex mutex;
+  std::condition_variable cond;
+#endif
+  auto claim = [&] (bool wait) {
+#ifndef NTHREADS
+    std::unique_lock<std::mutex> lock (mutex);
+#endif
+    for (;;) {
+      if (stop || next >= n)
+        return n;
+      if (next < added + window)
+        return next++;
+      if (!wait)
+        return n;
+#ifndef NTHREADS
+      cond.wait (lock);
+#endif
+    }
+  };
+
+#ifndef NTHREADS
+  vector<std::thread> threads;
+  for (size_t i = 1; i < jobs; i++)
+    threads.push_back (std::thread ([&] () {
+      size_t j;
+      while ((j = claim (true)) < n)
+        scan_dimacs_chunk_and_flag (chunks[j], vars, forced);
+    }));
+  if (jobs > 1)
+    MSG ("scanning %zu chunks with %zu threads", n, jobs);
+#endif
+
+  size_t resume = size;
+  uint64_t lineno = file->lineno ();
+  for (size_t i = 0; i < n; i++) {
+    DimacsChunk &chunk = chunks[i];
+    while (!chunk.ready.load (std::memory_order_acquire)) {
+      const size_t j = claim (false);
+      if (j < n)
+        scan_dimacs_chunk_and_flag (chunks[j], vars, forced);
+#ifndef NTHREADS
+      else
+        std::this_thread::yield ();
+#endif
+    }
+    if (chunk.failed ||
+        (!forced && (int64_t) parsed + chunk.clauses > clauses)) {
+      resume = bounds[i];
+      break;
+    }
+    for (const auto &other : chunk.lits)
+      solver->add (other);
+    if (!chunk.lits.empty ())
+      lit = chunk.lits.back ();
+    if (chunk.max_var > vars)
+      vars = chunk.max_var;
+    parsed += chunk.clauses;
+    lineno += chunk.lines;
+    erase_vector (chunk.lits);
+    {
+#ifndef NTHREADS
+      std::lock_guard<std::mutex> lock (mutex);
+#endif
+      added = i + 1;
+    }
+#ifndef NTHREADS
+    cond.notify_all ();
+#endif
+  }
+
+  {
+#ifndef NTHREADS
+    std::lock_guard<std::mutex> lock (mutex);
+#endif
+    stop = true;
+  }
+#ifndef NTHREADS
+  cond.notify_all ();
+  for (auto &thread : threads)
+    thread.join ();
+#endif
+  file->unmap (start, size);
+
+  if (resume < size)
+    MSG ("continue parsing at line %" PRIu64, lineno);
+  if (!file->seek (resume, lineno))
+    PER ("failed to continue parsing after mapping file");
+
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Parsing CNF in DIMACS format.
 
 const char *Parser::parse_dimacs_non_profiled (int &vars, int strict) {
@@ -234,6 +473,12 @@ const char *Parser::parse_dimacs_non_profiled (int &vars, int strict) {
   // Now read body of DIMACS part.
   //
   int lit = 0, parsed = 0;
+  if (!found_inccnf_header) {
+    const char *err =
+        parse_dimacs_mapped (lit, parsed, vars, clauses, strict);
+    if (err)
+      return err;
+  }
   while ((ch = parse_char ()) != EOF) {
     if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r')
       continue;
@@ -0,0 +1,329 @@
+#include "internal.hpp"
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// Each worker is the terminator of its solver.  The primary worker also
+// forwards to the terminator originally connected by the user.
+
+struct PortfolioWorker : public Terminator {
+  Portfolio *portfolio;
+  Solver *solver;
+  Terminator *user;
+  Sharer sharer;
+  int res;
+  PortfolioWorker (Portfolio *, Solver *, int id);
+  bool terminate ();
+  void run ();
+  void conquer ();
+};
+
+struct Portfolio {
+  ShareRing ring;
+  std::atomic<bool> done;   // some worker finished
+  std::atomic<int> winning; // first worker with result ('-1' if none)
+  vector<Solver *> clones;  // kept until next 'solve' for 'val'
+  Solver *winner;           // solver of 'winning' worker
+
+  // Cube-and-conquer state.  Workers take the next cube from 'cubes'
+  // through 'next'.  The cores of refuted cubes are published in 'cores'
+  // (at most one per cube) and flagged in 'ready' after being written.
+  //
+  bool conquering;
+  vector<vector<int>> cubes;
+  vector<vector<int>> cores;
+  std::atomic<bool> *ready;
+  std::atomic<size_t> next;    // next cube to solve
+  std::atomic<size_t> cored;   // number of reserved cores
+  std::atomic<size_t> refuted; // solved or pruned unsatisfiable cubes
+  std::atomic<size_t> pruned;  // cubes subsumed by cores
+
+  Portfolio ()
+      : done (false), winning (-1), winner (0), conquering (false),
+        ready (0), next (0), cored (0), refuted (0), pruned (0) {}
+  ~Portfolio () { delete[] ready; }
+
+  void add_core (const vector<int> &core);
+  bool subsumed (const vector<int> &cube);
+};
+
+// Cores are only added while the cubes are solved, so a simple lock-free
+// append-only array with one slot per cube suffices.
+
+void Portfolio::add_core (const vector<int> &core) {
+  const size_t i = cored.fetch_add (1);
+  assert (i < cubes.size ());
+  cores[i] = core;
+  ready[i].store (true, std::memory_order_release);
+}
+
+bool Portfolio::subsumed (const vector<int> &cube) {
+  const size_t end = cored.load (std::memory_order_relaxed);
+  for (size_t i = 0; i < end; i++) {
+    if (!ready[i].load (std::memory_order_acquire))
+      continue;
+    bool contained = true;
+    for (auto lit : cores[i])
+      if (std::find (cube.begin (), cube.end (), lit) == cube.end ()) {
+        contained = false;
+        break;
+      }
+    if (contained)
+      return true;
+  }
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+
+PortfolioWorker::PortfolioWorker (Portfolio *p, Solver *s, int id)
+    : portfolio (p), solver (s), user (0), sharer (&p->ring, id),
+      res (0) {}
+
+bool PortfolioWorker::terminate () {
+  if (portfolio->done.load (std::memory_order_relaxed))
+    return true;
+  return user && user->terminate ();
+}
+
+void PortfolioWorker::run () {
+  if (portfolio->conquering)
+    conquer ();
+  else
+    res = solver->solve ();
+  if (res) {
+    int none = -1;
+    portfolio->winning.compare_exchange_strong (none, sharer.id);
+  }
+  if (res || !portfolio->conquering)
+    portfolio->done.store (true, std::memory_order_relaxed);
+}
+
+// Solve cubes as assumptions until a satisfiable cube is found, the formula
+// is shown to be unsatisfiable (empty core) or all cubes are taken.  Cubes
+// subsumed by the core of an already refuted cube are skipped.
+
+void PortfolioWorker::conquer () {
+  Portfolio &p = *portfolio;
+  const size_t size = p.cubes.size ();
+  while (!p.done.load (std::memory_order_relaxed)) {
+    const size_t i = p.next.fetch_add (1);
+    if (i >= size)
+      break;
+    const vector<int> &cube = p.cubes[i];
+    if (p.subsumed (cube)) {
+      p.pruned++;
+      p.refuted++;
+      continue;
+    }
+    for (auto lit : cube)
+      solver->assume (lit);
+    res = solver->solve ();
+    if (res == 10)
+      return;
+    if (!res) {
+      p.done = true; // Terminated or limit hit.
+      break;
+    }
+    assert (res == 20);
+    vector<int> core;
+    for (auto lit : cube)
+      if (solver->failed (lit))
+        core.push_back (lit);
+    if (core.empty ())
+      return; // Formula itself unsatisfiable.
+    p.add_core (core);
+    p.refuted++;
+  }
+  res = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+PortfolioSolver::PortfolioSolver (Solver *s, int t)
+    : primary (s), threads (t), portfolio (new Portfolio ()) {
+  REQUIRE (primary, "zero primary solver");
+  REQUIRE (threads > 0, "invalid number of threads '%d'", threads);
+}
+
+PortfolioSolver::~PortfolioSolver () {
+  for (auto clone : portfolio->clones)
+    delete clone;
+  delete portfolio;
+}
+
+// The first clone uses the same options but a different seed, then we
+// alternate initial phases and the 'sat' and 'unsat' configurations.
+
+static void diversify (Options &opts, int id) {
+  opts.set ("seed", opts.seed + id);
+  if (id & 1)
+    opts.set ("phase", !opts.phase);
+  const int config = (id / 2) % 3;
+  if (config == 1)
+    Config::set (opts, "sat");
+  else if (config == 2)
+    Config::set (opts, "unsat");
+  opts.set ("quiet", 1);
+  opts.set ("report", 0);
+  opts.set ("verbose", 0);
+}
+
+int PortfolioSolver::workers () {
+  int res = threads;
+#ifdef NTHREADS
+  res = 1;
+#endif
+  if (primary->internal->tracer || primary->external->propagator)
+    res = 1;
+  return res;
+}
+
+int PortfolioSolver::run (int workers) {
+
+  for (auto clone : portfolio->clones)
+    delete clone;
+  portfolio->clones.clear ();
+  portfolio->winner = 0;
+
+  // Copy the formula into the clones and transfer assumptions and the
+  // constraint, which are not part of 'copy'.
+
+  External *external = primary->external;
+  const int max_var = primary->vars ();
+  for (int id = 1; id < workers; id++) {
+    Solver *clone = new Solver ();
+    primary->copy (*clone);
+    diversify (clone->internal->opts, id);
+    clone->reserve (max_var);
+    for (auto lit : external->assumptions)
+      clone->assume (lit);
+    for (auto lit : external->constraint)
+      clone->constrain (lit);
+    portfolio->clones.push_back (clone);
+  }
+
+  portfolio->done = false;
+  portfolio->winning = -1;
+
+  vector<PortfolioWorker *> team;
+  team.push_back (new PortfolioWorker (portfolio, primary, 0));
+  team.back ()->user = external->terminator;
+  for (int id = 1; id < workers; id++)
+    team.push_back (
+        new PortfolioWorker (portfolio, portfolio->clones[id - 1], id));
+  for (auto worker : team) {
+    worker->solver->external->terminator = worker;
+    if (workers > 1)
+      worker->solver->internal->sharer = &worker->sharer;
+  }
+
+#ifndef NTHREADS
+  vector<std::thread> running;
+  for (size_t i = 1; i < team.size (); i++)
+    running.push_back (std::thread (&PortfolioWorker::run, team[i]));
+#endif
+  team[0]->run ();
+#ifndef NTHREADS
+  for (auto &thread : running)
+    thread.join ();
+#endif
+
+  // Even if the primary solver was terminated by the user, a clone might
+  // have finished in the mean time and we take its result.
+
+  int res = 0;
+  const int winning = portfolio->winning;
+  if (winning >= 0) {
+    res = team[winning]->res;
+    portfolio->winner = team[winning]->solver;
+    if (workers > 1)
+      primary->verbose (1, "portfolio worker %d won with result %d",
+                        winning, res);
+  }
+
+  for (auto worker : team) {
+    worker->solver->external->terminator = 0;
+    worker->solver->internal->sharer = 0;
+  }
+  external->terminator = team[0]->user;
+  for (auto worker : team)
+    delete worker;
+
+  return res;
+}
+
+int PortfolioSolver::solve () {
+  const int n = workers ();
+  if (n > 1)
+    primary->verbose (1, "solving with portfolio of %d workers", n);
+  portfolio->conquering = false;
+  return run (n);
+}
+
+// Cube-and-conquer splits the formula with 'generate_cubes' on the primary
+// solver and then solves the cubes as assumptions on all workers.  If all
+// cubes are refuted the formula is unsatisfiable.  If lookahead already
+// solves the formula or does not produce any cube we fall back to 'solve'.
+// We also do so while tracing proofs, since refuting all cubes does not
+// produce the empty clause.
+
+int PortfolioSolver::cube_and_conquer (int depth) {
+  REQUIRE (depth >= 0, "negative cube depth '%d'", depth);
+  REQUIRE (primary->external->assumptions.empty (),
+           "can not use assumptions in cube-and-conquer");
+  REQUIRE (primary->external->constraint.empty (),
+           "can not use constraint in cube-and-conquer");
+
+  if (primary->internal->tracer)
+    return solve ();
+
+  Solver::CubesWithStatus cubes = primary->generate_cubes (depth);
+  if (cubes.status || cubes.cubes.empty ())
+    return solve ();
+
+  const int n = workers ();
+  primary->verbose (1, "conquering %zu cubes of depth %d with %d workers",
+                    cubes.cubes.size (), depth, n);
+
+  Portfolio &p = *portfolio;
+  p.conquering = true;
+  p.cubes.swap (cubes.cubes);
+  p.cores.clear ();
+  p.cores.resize (p.cubes.size ());
+  delete[] p.ready;
+  p.ready = new std::atomic<bool>[p.cubes.size ()];
+  for (size_t i = 0; i < p.cubes.size (); i++)
+    p.ready[i] = false;
+  p.next = p.cored = p.refuted = p.pruned = 0;
+
+  int res = run (n);
+  if (!res && p.refuted == p.cubes.size ())
+    res = 20;
+
+  primary->verbose (1, "refuted %zu cubes (%zu pruned by cores)",
+                    (size_t) p.refuted, (size_t) p.pruned);
+  p.conquering = false;
+  return res;
+}
+
+int PortfolioSolver::val (int lit) {
+  REQUIRE (portfolio->winner, "no satisfiable result");
+  return portfolio->winner->val (lit);
+}
+
+bool PortfolioSolver::failed (int lit) {
+  REQUIRE (portfolio->winner, "no unsatisfiable result");
+  return portfolio->winner->failed (lit);
+}
+
+Solver *PortfolioSolver::winner () { return portfolio->winner; }
+
+void PortfolioSolver::terminate () { portfolio->done = true; }
+
+} // namespace CaDiCaL
@@ -153,7 +153,7 @@ int Internal::probe_dominator (int a, int b) {
   int l = a, k = b;
   Var *u = &var (l), *v = &var (k);
   assert (val (l) > 0), assert (val (k) > 0);
-  assert (u->level == 1), assert (v->level == 1);
+  assert (u->level == level), assert (v->level == level);
   while (l != k) {
     if (u->trail > v->trail)
       swap (l, k), swap (u, v);
@@ -162,7 +162,7 @@ int Internal::probe_dominator (int a, int b) {
     int parent = get_parent_reason_literal (k);
     assert (parent), assert (val (parent) > 0);
     v = &var (k = parent);
-    assert (v->level == 1);
+    assert (v->level == level);
   }
   LOG ("dominator %d of %d and %d", l, a, b);
   assert (val (l) > 0);
@@ -175,7 +175,10 @@ int Internal::probe_dominator (int a, int b) {
 // It turned out, that most of the hyper-binary resolvents were generated
 // during probing on decision level one anyhow.  Thus this version is
 // specialized to decision level one, where actually all long (non-binary)
-// forcing clauses can be resolved to become binary.  So if we find a clause
+// forcing clauses can be resolved to become binary.  This also holds on
+// decision level two of probe trees (see 'probe_tree' below), since there
+// the decision implies the decision on level one through a binary clause
+// and thus dominates all literals assigned on both levels.  So if we find a clause
 // which would force a new assignment at decision level one during probing
 // we resolve it (the 'reason' argument) to obtain a hyper binary resolvent.
 // It consists of the still unassigned literal (the new unit) and the
@@ -218,7 +221,7 @@ int Internal::probe_dominator (int a, int b) {
 
 inline int Internal::hyper_binary_resolve (Clause *reason) {
   require_mode (PROBE);
-  assert (level == 1);
+  assert (level == 1 || level == 2);
   assert (reason->size > 2);
   const const_literal_iterator end = reason->end ();
   const int *lits = reason->literals;
@@ -228,7 +231,7 @@ inline int Internal::hyper_binary_resolve (Clause *reason) {
   assert (!val (lits[0]));
   for (k = lits + 1; k != end; k++)
     assert (val (*k) < 0);
-  assert (var (lits[1]).level == 1);
+  assert (var (lits[1]).level == level);
 #endif
   LOG (reason, "hyper binary resolving");
   stats.hbrs++;
@@ -238,9 +241,13 @@ inline int Internal::hyper_binary_resolve (Clause *reason) {
   for (k = lits + 2; k != end; k++) {
     const int other = -*k;
     assert (val (other) > 0);
-    if (!var (other).level)
+    const int other_level = var (other).level;
+    if (!other_level)
       continue;
-    dom = probe_dominator (dom, other);
+    if (other_level < level)
+      dom = control[level].decision;
+    else
+      dom = probe_dominator (dom, other);
     non_root_level_literals++;
   }
   probe_reason = reason;
@@ -307,7 +314,7 @@ inline void Internal::probe_assign (int lit, int parent) {
   if (!level)
     learn_unit_clause (lit);
   else
-    assert (level == 1);
+    assert (level == 1 || level == 2);
   const signed char tmp = sign (lit);
   vals[idx] = tmp;
   vals[-idx] = -tmp;
@@ -384,29 +391,38 @@ inline void Internal::probe_lrat_for_units (int lit) {
 // perform hyper binary resolution and thus actually build an implication
 // tree instead of a DAG.  Statistics counters are also different.
 
+// Binary clauses are propagated over the binary implication graph snapshot
+// including the hyper binary resolvents added during probing.
+
+inline void Internal::probe_propagate_bin_edge (int lit, const BinEdge &e) {
+  const signed char b = val (e.lit);
+  if (b > 0)
+    return;
+  if (b < 0)
+    conflict = e.clause; // but continue
+  else {
+    assert (lrat_chain.empty ());
+    assert (!probe_reason);
+    probe_reason = e.clause;
+    probe_lrat_for_units (e.lit);
+    probe_assign (e.lit, -lit);
+    lrat_chain.clear ();
+  }
+}
+
 inline void Internal::probe_propagate2 () {
   require_mode (PROBE);
+  assert (bin_graph.valid);
+  const BinGraph &g = bin_graph;
   while (propagated2 != trail.size ()) {
     const int lit = -trail[propagated2++];
     LOG ("probe propagating %d over binary clauses", -lit);
-    Watches &ws = watches (lit);
-    for (const auto &w : ws) {
-      if (!w.binary ())
-        continue;
-      const signed char b = val (w.blit);
-      if (b > 0)
-        continue;
-      if (b < 0)
-        conflict = w.clause; // but continue
-      else {
-        assert (lrat_chain.empty ());
-        assert (!probe_reason);
-        probe_reason = w.clause;
-        probe_lrat_for_units (w.blit);
-        probe_assign (w.blit, -lit);
-        lrat_chain.clear ();
-      }
-    }
+    for (const auto &e : bin_edges (lit))
+      probe_propagate_bin_edge (lit, e);
+    if (g.heads.empty ())
+      continue;
+    for (unsigned i = g.heads[vlit (lit)]; i; i = g.added[i - 1].next)
+      probe_propagate_bin_edge (lit, g.added[i - 1].edge);
   }
 }
 
@@ -414,6 +430,8 @@ bool Internal::probe_propagate () {
   require_mode (PROBE);
   assert (!unsat);
   START (propagate);
+  if (!bin_graph.valid)
+    update_bin_graph ();
   int64_t before = propagated2 = propagated;
   while (!conflict) {
     if (propagated2 != trail.size ())
@@ -445,11 +463,13 @@ bool Internal::probe_propagate () {
           literal_iterator k = middle;
           int r = 0;
           signed char v = -1;
+          k = skip_false_literals (k, end);
           while (k != end && (v = val (r = *k)) < 0)
             k++;
           if (v < 0) {
             k = lits + 2;
             assert (w.clause->pos <= size);
+            k = skip_false_literals (k, middle);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
@@ -465,7 +485,7 @@ bool Internal::probe_propagate () {
             watch_literal (r, lit, w.clause);
             j--;
           } else if (!u) {
-            if (level == 1) {
+            if (level) {
               lits[0] = other, lits[1] = lit;
               assert (lrat_chain.empty ());
               assert (!probe_reason);
@@ -768,6 +788,151 @@ int Internal::next_probe () {
   }
 }
 
+/*------------------------------------------------------------------------*/
+
+// Tree based probing (see our CPAIOR'13 paper on tree based look ahead)
+// shares the propagation of literals implied by several probes.  Since
+// roots of the binary implication graph are probed, we use trees of depth
+// one: the tree root is a literal implied by the probe through a binary
+// clause, which is assigned and propagated on decision level one.  Then
+// the probe and all other scheduled roots implying the tree root are
+// assigned on decision level two on top of it, where only their remaining
+// implications are propagated and undone again.  Since such a probe also
+// implies the tree root, both levels together are the same as propagating
+// the probe alone.  Thus a conflict on level two shows that the probe is
+// a failed literal, which we then probe again on its own to let
+// 'failed_literal' derive units (and LRAT chains) as before.
+
+// During propagation on decision level two the binary clause connecting
+// the probe to the tree root is used as reason of the tree root, such that
+// 'probe_dominator_lrat' can justify hyper binary resolvents with the
+// probe as dominator.
+
+// Pick the implied literal with most implicants as tree root.
+
+int Internal::probe_tree_root (int probe, Clause *&edge) {
+  int res = 0;
+  size_t best = 1;
+  for (const auto &e : bin_edges (-probe)) {
+    const int root = e.lit;
+    if (e.clause->garbage)
+      continue;
+    if (!active (root) || val (root))
+      continue;
+    const size_t implicants = bin_edges (root).size ();
+    if (implicants <= best)
+      continue;
+    best = implicants;
+    edge = e.clause;
+    res = root;
+  }
+  return res;
+}
+
+// Probes have to be roots of the binary implication graph.
+
+bool Internal::probe_tree_leaf (int lit) {
+  for (const auto &e : bin_edges (lit))
+    if (!e.clause->garbage && !fixed (e.lit))
+      return false;
+  return true;
+}
+
+// Assign 'probe' on decision level one, or on level two on top of 'root'.
+
+bool Internal::probe_tree_probe (int probe, int root, Clause *edge) {
+  if (!root) {
+    probe_assign_decision (probe);
+    if (probe_propagate ()) {
+      backtrack ();
+      return true;
+    }
+    failed_literal (probe);
+    return false;
+  }
+  assert (level == 1);
+  assert (propagated == trail.size ());
+  LOG (edge, "probing %d on top of tree root %d through", probe, root);
+  level++;
+  control.push_back (Level (probe, trail.size ()));
+  probe_assign (probe, 0);
+  Var &v = var (root);
+  assert (v.level == 1), assert (!v.reason);
+  v.reason = edge;
+  const bool res = probe_propagate ();
+  conflict = 0;
+  backtrack (1);
+  v.reason = 0;
+  return res;
+}
+
+void Internal::probe_tree (int probe, int64_t limit) {
+  if (!bin_graph.valid)
+    update_bin_graph ();
+  Clause *edge = 0;
+  const int root = probe_tree_root (probe, edge);
+
+  // Collect the other probes implying the root first, which also avoids
+  // traversing the implication graph while hyper binary resolvents are
+  // added.  Without other probes there is nothing to share.
+  //
+  vector<BinEdge> children;
+  if (root)
+    for (const auto &e : bin_edges (root)) {
+      const int child = -e.lit;
+      if (child == probe || e.clause->garbage)
+        continue;
+      if (!active (child) || val (child))
+        continue;
+      if (propfixed (child) >= stats.all.fixed)
+        continue;
+      if (probe_tree_leaf (child))
+        children.push_back (e);
+    }
+  if (children.empty ()) {
+    probe_tree_probe (probe, 0, 0);
+    return;
+  }
+
+  LOG ("probing tree root %d with %zd other probes", root,
+       children.size ());
+  stats.probetrees++;
+  probe_assign_decision (root);
+  if (!probe_propagate ()) {
+    failed_literal (root);
+    return;
+  }
+
+  vector<int> failed;
+  if (!val (probe) && !probe_tree_probe (probe, root, edge))
+    failed.push_back (probe);
+  clean_probehbr_lrat ();
+
+  for (const auto &e : children) {
+    if (terminated_asynchronously () || stats.propagations.probe >= limit)
+      break;
+    const int child = -e.lit;
+    if (val (child) || propfixed (child) >= stats.all.fixed)
+      continue;
+    stats.probed++;
+    stats.probetreed++;
+    if (!probe_tree_probe (child, root, e.clause))
+      failed.push_back (child);
+    clean_probehbr_lrat ();
+  }
+  backtrack ();
+
+  for (const auto &lit : failed) {
+    if (unsat)
+      break;
+    if (!active (lit) || val (lit))
+      continue;
+    LOG ("probing failed tree probe %d again", lit);
+    probe_tree_probe (lit, 0, 0);
+    clean_probehbr_lrat ();
+  }
+}
+
 bool Internal::probe_round () {
 
   if (unsat)
@@ -822,11 +987,10 @@ bool Internal::probe_round () {
          stats.propagations.probe < limit && (probe = next_probe ())) {
     stats.probed++;
     LOG ("probing %d", probe);
-    probe_assign_decision (probe);
-    if (probe_propagate ())
-      backtrack ();
+    if (opts.probetree)
+      probe_tree (probe, limit);
     else
-      failed_literal (probe);
+      probe_tree_probe (probe, 0, 0);
     clean_probehbr_lrat ();
   }
 
@@ -30,6 +30,7 @@ void Internal::build_full_lrat () {
 void Internal::trace (File *file) {
   assert (!tracer);
   new_proof_on_demand ();
+  file->buffer ((size_t) opts.proofbuffer << 20, opts.proofasync);
   tracer = new Tracer (this, file, opts.binary, opts.lrat, opts.lratfrat,
                        opts.lratveripb);
   LOG ("PROOF connecting proof tracer");
@@ -414,6 +414,7 @@ bool Internal::propagate () {
           int r = 0;
           signed char v = -1;
 
+          k = skip_false_literals (k, end);
           while (k != end && (v = val (r = *k)) < 0)
             k++;
 
@@ -421,6 +422,7 @@ bool Internal::propagate () {
 
             k = lits + 2;
             assert (w.clause->pos <= size);
+            k = skip_false_literals (k, middle);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
@@ -1053,6 +1055,7 @@ bool Internal::propagate_multitrail () {
             int r = 0;
             signed char v = -1;
 
+            k = skip_false_literals (k, end);
             while (k != end && (v = val (r = *k)) < 0)
               k++;
 
@@ -1060,6 +1063,7 @@ bool Internal::propagate_multitrail () {
 
               k = lits + 2;
               assert (w.clause->pos <= size);
+              k = skip_false_literals (k, middle);
               while (k != middle && (v = val (r = *k)) < 0)
                 k++;
             }
@@ -1462,6 +1466,7 @@ bool Internal::propagate_clean () {
           int r = 0;
           signed char v = -1;
 
+          k = skip_false_literals (k, end);
           while (k != end && (v = val (r = *k)) < 0)
             k++;
 
@@ -1469,6 +1474,7 @@ bool Internal::propagate_clean () {
 
             k = lits + 2;
             assert (w.clause->pos <= size);
+            k = skip_false_literals (k, middle);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
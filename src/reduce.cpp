@@ -61,21 +61,17 @@ void Internal::mark_clauses_to_be_flushed () {
 // IJCAI'09 paper and keep all low glue clauses limited by
 // 'options.keepglue' (typically '2').
 //
-// In earlier versions we pre-computed a 64-bit sort key per clause and
-// wrapped a pointer to the clause and the 64-bit sort key into a separate
-// data structure for sorting.  This was probably faster but awkward and
-// so we moved back to a simpler scheme which also uses 'stable_sort'
-// instead of 'rsort' below.  Sorting here is not a hot-spot anyhow.
-
-struct reduce_less_useful {
-  bool operator() (const Clause *c, const Clause *d) const {
-    if (c->glue > d->glue)
-      return true;
-    if (c->glue < d->glue)
-      return false;
-    return c->size > d->size;
-  }
-};
+// Candidates are not sorted completely anymore, since we only need to know
+// which of them are reduced.  Instead we select the key of the last reduced
+// candidate in linear time and then reduce all candidates with a larger key
+// and as many of the remaining candidates with the same key as needed in
+// the order of 'clauses'.  This gives exactly the same result as stable
+// sorting with respect to decreasing keys, but avoids the logarithmic
+// factor, which matters with millions of learned clauses.
+
+inline static uint64_t reduce_key (const Clause *c) {
+  return ((uint64_t) (unsigned) c->glue << 32) + (unsigned) c->size;
+}
 
 // This function implements the important reduction policy. It determines
 // which redundant clauses are considered not useful and thus will be
@@ -83,11 +79,11 @@ struct reduce_less_useful {
 
 void Internal::mark_useless_redundant_clauses_as_garbage () {
 
-  // We use a separate stack for sorting candidates for removal.  This uses
-  // (slightly) more memory but has the advantage to keep the relative order
-  // in 'clauses' intact, which actually due to using stable sorting goes
-  // into the candidate selection (more recently learned clauses are kept if
-  // they otherwise have the same glue and size).
+  // We use a separate stack for selecting candidates for removal.  This
+  // uses (slightly) more memory but has the advantage to keep the relative
+  // order in 'clauses' intact, which actually goes into the candidate
+  // selection (more recently learned clauses are kept if they otherwise
+  // have the same glue and size).
 
   vector<Clause *> stack;
 
@@ -117,8 +113,6 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
     stack.push_back (c);
   }
 
-  stable_sort (stack.begin (), stack.end (), reduce_less_useful ());
-
   size_t target = 1e-2 * opts.reducetarget * stack.size ();
 
   // This is defensive code, which I usually consider a bug, but here I am
@@ -131,25 +125,48 @@ void Internal::mark_useless_redundant_clauses_as_garbage () {
   PHASE ("reduce", stats.reductions, "reducing %zd clauses %.0f%%", target,
          percent (target, stats.current.redundant));
 
-  auto i = stack.begin ();
-  const auto t = i + target;
-  while (i != t) {
-    Clause *c = *i++;
-    LOG (c, "marking useless to be collected");
-    mark_garbage (c);
-    stats.reduced++;
+  // Select the key 'limit' of the least useless reduced candidate and
+  // count how many candidates with that key have to be reduced.
+  //
+  uint64_t limit = UINT64_MAX;
+  size_t equal = 0;
+  if (target) {
+    vector<uint64_t> keys;
+    keys.reserve (stack.size ());
+    for (const auto &c : stack)
+      keys.push_back (reduce_key (c));
+    const auto nth = keys.begin () + (target - 1);
+    nth_element (keys.begin (), nth, keys.end (), greater<uint64_t> ());
+    limit = *nth;
+    size_t larger = 0;
+    for (auto k = keys.begin (); k != nth; k++)
+      if (*k > limit)
+        larger++;
+    equal = target - larger;
   }
 
   lim.keptsize = lim.keptglue = 0;
 
-  const auto end = stack.end ();
-  for (i = t; i != end; i++) {
-    Clause *c = *i;
-    LOG (c, "keeping");
-    if (c->size > lim.keptsize)
-      lim.keptsize = c->size;
-    if (c->glue > lim.keptglue)
-      lim.keptglue = c->glue;
+  for (const auto &c : stack) {
+    const uint64_t key = reduce_key (c);
+    bool useless = false;
+    if (key > limit)
+      useless = true;
+    else if (key == limit && equal) {
+      equal--;
+      useless = true;
+    }
+    if (useless) {
+      LOG (c, "marking useless to be collected");
+      mark_garbage (c);
+      stats.reduced++;
+    } else {
+      LOG (c, "keeping");
+      if (c->size > lim.keptsize)
+        lim.keptsize = c->size;
+      if (c->glue > lim.keptglue)
+        lim.keptglue = c->glue;
+    }
   }
 
   erase_vector (stack);
@@ -20,6 +20,7 @@ extern "C" {
 
 #else
 
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -150,4 +151,55 @@ uint64_t current_resident_set_size () {
 
 /*------------------------------------------------------------------------*/
 
+// Large tables which are accessed randomly, most importantly the clause
+// arena, suffer from TLB misses during propagation.  For those we can
+// allocate memory with an anonymous 'mmap' and advise the kernel to back
+// it with transparent huge pages.  Since the pages are only mapped on first
+// touch, which happens in the thread filling the table, they are placed on
+// the NUMA node of that thread by the default first-touch policy.  If
+// mapping fails (or is not supported) a zero pointer is returned and the
+// caller has to fall back to standard allocation.
+
+#ifdef __WIN32
+
+char *allocate_huge_pages (size_t) { return 0; }
+void deallocate_huge_pages (char *, size_t) {}
+uint64_t huge_pages_resident_set_size () { return 0; }
+
+#else
+
+char *allocate_huge_pages (size_t bytes) {
+  const int prot = PROT_READ | PROT_WRITE;
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  void *res = mmap (0, bytes, prot, flags, -1, 0);
+  if (res == MAP_FAILED)
+    return 0;
+#ifdef MADV_HUGEPAGE
+  (void) madvise (res, bytes, MADV_HUGEPAGE);
+#endif
+  return (char *) res;
+}
+
+void deallocate_huge_pages (char *p, size_t bytes) { munmap (p, bytes); }
+
+// Again this is Linux specific and returns zero if '/proc' does not provide
+// the amount of anonymous memory backed by transparent huge pages.
+
+uint64_t huge_pages_resident_set_size () {
+  FILE *file = fopen ("/proc/self/smaps_rollup", "r");
+  if (!file)
+    return 0;
+  char line[128];
+  uint64_t res = 0;
+  while (fgets (line, sizeof line, file))
+    if (sscanf (line, "AnonHugePages: %" PRIu64 " kB", &res) == 1)
+      break;
+  fclose (file);
+  return res << 10;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 } // namespace CaDiCaL
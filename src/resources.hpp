@@ -9,6 +9,10 @@ double absolute_process_time ();
 uint64_t maximum_resident_set_size ();
 uint64_t current_resident_set_size ();
 
+char *allocate_huge_pages (size_t bytes);
+void deallocate_huge_pages (char *, size_t bytes);
+uint64_t huge_pages_resident_set_size ();
+
 } // namespace CaDiCaL
 
 #endif // ifndef _resources_hpp_INCLUDED
@@ -118,7 +118,11 @@ void Internal::restart () {
   if (stable)
     stats.restartstable++;
   LOG ("restart %" PRId64 "", stats.restarts);
-  backtrack (reuse_trail ());
+  if (importable ()) {
+    backtrack ();
+    import_shared_clauses ();
+  } else
+    backtrack (reuse_trail ());
 
   lim.restart = stats.conflicts + opts.restartint;
   LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
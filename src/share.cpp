@@ -0,0 +1,276 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+ShareRing::ShareRing () : head (0) {
+  slots = new ShareSlot[capacity];
+  for (uint64_t i = 0; i < capacity; i++)
+    slots[i].stamp.store (0, std::memory_order_relaxed);
+}
+
+ShareRing::~ShareRing () { delete[] slots; }
+
+void ShareRing::push (int source, const int *lits, int size, int glue) {
+  assert (0 < size && (unsigned) size <= max_size);
+  const uint64_t pos = head.fetch_add (1, std::memory_order_relaxed);
+  ShareSlot &slot = slots[pos % capacity];
+  uint64_t stamp = slot.stamp.load (std::memory_order_relaxed);
+  if (stamp & 1)
+    return; // Still written by a producer we lapped.
+  if (stamp >= 2 * pos + 2)
+    return; // Already overwritten by a producer lapping us.
+  if (!slot.stamp.compare_exchange_strong (stamp, 2 * pos + 1,
+                                           std::memory_order_relaxed))
+    return;
+  std::atomic_thread_fence (std::memory_order_release);
+  slot.source.store (source, std::memory_order_relaxed);
+  slot.size.store (size, std::memory_order_relaxed);
+  slot.glue.store (glue, std::memory_order_relaxed);
+  for (int i = 0; i < size; i++)
+    slot.lits[i].store (lits[i], std::memory_order_relaxed);
+  slot.stamp.store (2 * pos + 2, std::memory_order_release);
+}
+
+int ShareRing::read (uint64_t pos, int *lits, int &source,
+                     int &glue) const {
+  const ShareSlot &slot = slots[pos % capacity];
+  const uint64_t expected = 2 * pos + 2;
+  const uint64_t before = slot.stamp.load (std::memory_order_acquire);
+  if (before == expected - 1)
+    return -1;
+  if (before != expected)
+    return 0;
+  source = slot.source.load (std::memory_order_relaxed);
+  glue = slot.glue.load (std::memory_order_relaxed);
+  int size = slot.size.load (std::memory_order_relaxed);
+  if (size < 1 || (unsigned) size > max_size)
+    size = 0;
+  for (int i = 0; i < size; i++)
+    lits[i] = slot.lits[i].load (std::memory_order_relaxed);
+  std::atomic_thread_fence (std::memory_order_acquire);
+  const uint64_t after = slot.stamp.load (std::memory_order_relaxed);
+  if (after != expected)
+    return 0;
+  return size;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Export hooks called from 'learn_unit_clause' and
+// 'new_learned_redundant_clause'.  Learned clauses are implied by the
+// irredundant clauses of the exporting worker which in turn are all
+// implied by the formula the workers were cloned from.  Thus it is safe
+// for any other worker to add them as redundant clauses.
+
+void Internal::export_shared_unit (int ilit) {
+  assert (sharer);
+  if (sharer->importing)
+    return;
+  const int elit = externalize (ilit);
+  assert (elit);
+  LOG ("exporting shared unit %d", ilit);
+  sharer->ring->push (sharer->id, &elit, 1, 1);
+  stats.shared.exported++;
+}
+
+void Internal::export_shared_clause (int glue) {
+  assert (sharer);
+  const size_t size = clause.size ();
+  assert (size > 1);
+  if (size > (size_t) opts.sharesize)
+    return;
+  if (glue > opts.shareglue)
+    return;
+  int elits[ShareRing::max_size];
+  for (size_t i = 0; i < size; i++) {
+    const int elit = externalize (clause[i]);
+    assert (elit);
+    elits[i] = elit;
+  }
+  LOG (clause, "exporting shared glue %d", glue);
+  sharer->ring->push (sharer->id, elits, (int) size, glue);
+  stats.shared.exported++;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Imported clauses are only added on the root level, i.e., at the next
+// restart (which then backtracks to the root level instead of reusing the
+// trail) or if the solver already is on the root level, thus the restart
+// policy is not changed by importing clauses.  They are mapped
+// through 'e2i' and dropped if they contain a variable which is not
+// active any more (eliminated, substituted or pure), while root-level
+// satisfied and tautological clauses are skipped and falsified and
+// duplicated literals removed.  Since clauses shared by other workers do
+// not have a derivation in our proof, importing them is disabled if proofs
+// are traced or checked.  Clauses queued through the API are trusted
+// instead and traced as (external) original clauses (see below).
+
+bool Internal::importable () {
+  if (!external->imports.empty ())
+    return true;
+  if (!sharer)
+    return false;
+  if (stats.conflicts < lim.import)
+    return false;
+  if (proof || opts.lrat)
+    return false;
+  return sharer->imported != sharer->ring->position ();
+}
+
+bool Internal::importing () { return !level && importable (); }
+
+void Internal::import_shared_clause (const int *elits, int size, int glue) {
+  assert (clause.empty ());
+  assert (lrat_chain.empty ());
+  const bool chain = proof && opts.lrat && !opts.lratexternal;
+  bool skip = false;
+  for (int i = 0; !skip && i < size; i++) {
+    const int elit = elits[i];
+    const int eidx = abs (elit);
+    int ilit = eidx <= external->max_var ? external->e2i[eidx] : 0;
+    if (!ilit) {
+      LOG ("dropping imported clause with unmapped external %d", elit);
+      stats.shared.dropped++;
+      skip = true;
+      break;
+    }
+    if (elit < 0)
+      ilit = -ilit;
+    const Flags &f = flags (ilit);
+    if (f.fixed ()) {
+      if (val (ilit) > 0)
+        skip = true;
+      else if (chain) {
+        const unsigned uidx = (elit > 0) + 2u * (unsigned) eidx;
+        uint64_t id = external->ext_units[uidx];
+        if (!id)
+          id = unit_clauses[vlit (-ilit)];
+        assert (id);
+        lrat_chain.push_back (id);
+      }
+      continue;
+    }
+    if (!f.active ()) {
+      LOG ("dropping imported clause with inactive %d", ilit);
+      stats.shared.dropped++;
+      skip = true;
+      break;
+    }
+    const int tmp = marked (ilit);
+    if (tmp > 0)
+      continue;
+    if (tmp < 0)
+      skip = true;
+    else {
+      mark (ilit);
+      clause.push_back (ilit);
+    }
+  }
+  for (const auto &lit : clause)
+    unmark (lit);
+  if (skip) {
+    clause.clear ();
+    lrat_chain.clear ();
+    return;
+  }
+  stats.shared.imported++;
+  uint64_t id = 0;
+  if (proof) {
+    // Trusted imported clauses enter the proof as original clauses and are
+    // then strengthened just like original clauses added by the user.
+    id = ++clause_id;
+    vector<int> eclause (elits, elits + size);
+    proof->add_external_original_clause (id, eclause);
+    if (clause.size () < (size_t) size) {
+      const uint64_t new_id = ++clause_id;
+      if (chain) {
+        lrat_chain.push_back (id);
+        proof->add_derived_clause (new_id, clause, lrat_chain);
+      } else
+        proof->add_derived_clause (new_id, clause);
+      proof->delete_external_original_clause (id, eclause);
+      id = new_id;
+    }
+    lrat_chain.clear ();
+  }
+  if (clause.empty ()) {
+    LOG ("imported empty clause");
+    if (proof) {
+      unsat = true;
+      conflict_id = id;
+    } else
+      learn_empty_clause ();
+  } else if (clause.size () == 1) {
+    const int unit = clause[0];
+    LOG ("imported unit %d", unit);
+    assert (!val (unit));
+    if (proof)
+      assign_original_unit (id, unit);
+    else
+      assign_unit (unit);
+    stats.shared.units++;
+  } else {
+    Clause *c = new_clause (true, glue, id);
+    LOG (c, "imported");
+    watch_clause (c);
+  }
+  clause.clear ();
+}
+
+// Clauses queued by 'Solver::import_redundant_clause' are attached at the
+// next restart (or immediately if already on the root level).  They are
+// always imported as reducible clauses and thus their glue is raised above
+// the tier-one limit, which also protects against bogus small glues.
+
+void Internal::import_queued_clauses () {
+  assert (!level);
+  vector<int> &imports = external->imports;
+  LOG ("importing %zu queued literals, sizes and glues", imports.size ());
+  const int min_glue = opts.reducetier1glue + 1;
+  size_t i = 0;
+  while (!unsat && i < imports.size ()) {
+    const int size = imports[i++];
+    const int glue = max (min_glue, imports[i++]);
+    import_shared_clause (&imports[i], size, glue);
+    i += size;
+  }
+  erase_vector (imports);
+}
+
+void Internal::import_shared_clauses () {
+  assert (!unsat);
+  assert (!level);
+  START (import);
+  if (!external->imports.empty ())
+    import_queued_clauses ();
+  if (!sharer || unsat || proof || opts.lrat) {
+    STOP (import);
+    return;
+  }
+  ShareRing *ring = sharer->ring;
+  const uint64_t end = ring->position ();
+  uint64_t pos = sharer->imported;
+  if (end - pos > ShareRing::capacity)
+    pos = end - ShareRing::capacity;
+  int elits[ShareRing::max_size];
+  sharer->importing = true;
+  while (!unsat && pos < end) {
+    int source, glue;
+    const int size = ring->read (pos, elits, source, glue);
+    if (size < 0 && end - pos <= ShareRing::capacity / 2)
+      break; // Still written, so try again next time.
+    pos++;
+    if (size <= 0 || source == sharer->id)
+      continue;
+    import_shared_clause (elits, size, glue);
+  }
+  sharer->importing = false;
+  sharer->imported = pos;
+  lim.import = stats.conflicts + opts.shareint;
+  STOP (import);
+}
+
+} // namespace CaDiCaL
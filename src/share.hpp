@@ -0,0 +1,72 @@
+#ifndef _share_hpp_INCLUDED
+#define _share_hpp_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Clause sharing between the workers of a 'PortfolioSolver' goes through a
+// lock-free ring buffer of fixed size slots.  Each slot holds one learned
+// unit or short clause in terms of external literals, since the internal
+// variable indices of the workers diverge after compacting.  Producers
+// reserve a position with an atomic increment of the head and then claim
+// the corresponding slot by a compare-and-swap on its stamp, which makes
+// the stamp odd while the slot is written and even again after the clause
+// has been published.  Consumers validate the stamp before and after
+// copying a clause (like a sequence lock) and silently skip slots which
+// were overwritten in the mean time.  Sharing is best-effort: clauses
+// which do not fit or are overwritten before being imported are lost.
+
+struct ShareSlot {
+  std::atomic<uint64_t> stamp; // '2*pos + 2' if slot 'pos' is complete
+  std::atomic<int> source;     // worker which exported the clause
+  std::atomic<int> size;       // '1' for units
+  std::atomic<int> glue;
+  std::atomic<int> lits[16];
+};
+
+class ShareRing {
+
+  std::atomic<uint64_t> head;
+  ShareSlot *slots;
+
+public:
+  static const unsigned max_size = 16; // maximum shared clause size
+  static const uint64_t capacity = 1u << 14;
+
+  ShareRing ();
+  ~ShareRing ();
+
+  uint64_t position () const {
+    return head.load (std::memory_order_acquire);
+  }
+
+  // Publish a clause of external literals (dropped if slot is contended).
+  //
+  void push (int source, const int *lits, int size, int glue);
+
+  // Copy the clause at 'pos' into 'lits' and return its size.  Returns '0'
+  // if the slot has been overwritten or was never claimed for 'pos' (its
+  // producer dropped the clause) and '-1' if the clause is still being
+  // written.  The 'source' and 'glue' of the clause are stored too.
+  //
+  int read (uint64_t pos, int *lits, int &source, int &glue) const;
+};
+
+// Each worker has its own end-point to the ring connected to 'Internal'.
+
+struct Sharer {
+  ShareRing *ring;
+  int id;            // unique worker identifier
+  uint64_t imported; // next ring position to import
+  bool importing;    // avoid exporting imported units again
+  Sharer (ShareRing *r, int i)
+      : ring (r), id (i), imported (r->position ()), importing (false) {}
+};
+
+} // namespace CaDiCaL
+
+#endif
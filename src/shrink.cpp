@@ -73,7 +73,6 @@ int inline Internal::shrink_literal (int lit, int blevel,
     LOG ("skipping root level assigned %d", (lit));
     return 0;
   }
-  assert (v.reason != external_reason);
   if (f.shrinkable) {
     LOG ("skipping already shrinkable literal %d", (lit));
     return 0;
@@ -230,7 +229,10 @@ unsigned inline Internal::shrink_along_reason (int uip, int blevel,
   assert (v.level == blevel);
   assert (v.reason);
 
-  if (resolve_large_clauses || v.reason->size == 2) {
+  if (v.reason == external_reason) {
+    LOG ("can not resolve unexplained external reason of %i", uip);
+    failed_ptr = true;
+  } else if (resolve_large_clauses || v.reason->size == 2) {
     const Clause &c = *v.reason;
     LOG (v.reason, "resolving with reason");
     for (int lit : c) {
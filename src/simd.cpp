@@ -0,0 +1,45 @@
+#include "internal.hpp"
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace CaDiCaL {
+
+bool avx2_supported () {
+#ifdef HAVE_AVX2
+  __builtin_cpu_init ();
+  return __builtin_cpu_supports ("avx2");
+#else
+  return false;
+#endif
+}
+
+#ifdef HAVE_AVX2
+
+// The gather loads four bytes for each lane starting three bytes before
+// the value of the literal, which then ends up in the most significant
+// byte of the lane (little endian).  Thus the sign bits of the lanes,
+// extracted with a single 'movemask', are set exactly for false literals.
+// The three bytes of padding in front of 'vals' (see 'enlarge_vals')
+// make sure that this never reads outside of the allocated table.
+
+__attribute__ ((target ("avx2"))) int *
+avx2_skip_false_literals (const signed char *vals, int *begin,
+                          const int *end) {
+  const int *base = (const int *) (vals - 3);
+  int *k = begin;
+  while (end - k >= 8) {
+    const __m256i lits = _mm256_loadu_si256 ((const __m256i *) k);
+    const __m256i words = _mm256_i32gather_epi32 (base, lits, 1);
+    const unsigned mask = _mm256_movemask_ps (_mm256_castsi256_ps (words));
+    if (mask != 0xff)
+      return k + __builtin_ctz (~mask);
+    k += 8;
+  }
+  return k;
+}
+
+#endif
+
+} // namespace CaDiCaL
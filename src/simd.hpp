@@ -0,0 +1,34 @@
+#ifndef _simd_hpp_INCLUDED
+#define _simd_hpp_INCLUDED
+
+// Searching for a replacement watch in long clauses gathers the values of
+// the literals one by one.  On x86-64 compiled with GCC or Clang we
+// provide an AVX2 kernel in 'simd.cpp' which checks eight literals at once
+// with a single gather instruction.  It is only used if the CPU supports
+// AVX2, which is determined at run-time, since the rest of the solver is
+// compiled for the generic architecture, and further has to be enabled
+// with the option 'simd', since gathers only pay off if long runs of false
+// literals are skipped.  Compile with '-DNSIMD' (or configure with
+// '--no-simd') to remove it completely.
+
+#if !defined(NSIMD) && defined(__x86_64__) && defined(__GNUC__)
+#define HAVE_AVX2
+#endif
+
+namespace CaDiCaL {
+
+bool avx2_supported ();
+
+#ifdef HAVE_AVX2
+
+// Returns a pointer to the first literal in '[begin,end)' which is not
+// false or the first position where less than eight literals are left.
+
+int *avx2_skip_false_literals (const signed char *vals, int *begin,
+                               const int *end);
+
+#endif
+
+} // namespace CaDiCaL
+
+#endif // ifndef _simd_hpp_INCLUDED
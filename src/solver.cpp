@@ -813,6 +813,44 @@ void Solver::disconnect_learner () {
   LOG_API_CALL_END ("disconnect_learner");
 }
 
+void Solver::connect_batch_learner (BatchLearner *learner) {
+  LOG_API_CALL_BEGIN ("connect_batch_learner");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (learner, "can not connect zero batch learner");
+  if (external->batch_learner) {
+    LOG ("connecting new batch learner (disconnecting previous one)");
+    external->flush_batched_clauses ();
+  } else
+    LOG ("connecting new batch learner (no previous one)");
+  external->batch_learner = learner;
+  external->batched_conflicts = internal->stats.conflicts;
+  LOG_API_CALL_END ("connect_batch_learner");
+}
+
+void Solver::disconnect_batch_learner () {
+  LOG_API_CALL_BEGIN ("disconnect_batch_learner");
+  REQUIRE_VALID_STATE ();
+  if (external->batch_learner) {
+    LOG ("disconnecting previous batch learner");
+    external->flush_batched_clauses ();
+  } else
+    LOG ("ignoring to disconnect batch learner (no previous one)");
+  external->batch_learner = 0;
+  LOG_API_CALL_END ("disconnect_batch_learner");
+}
+
+void Solver::import_redundant_clause (const int *lits, size_t size,
+                                      int glue) {
+  LOG_API_CALL_BEGIN ("import_redundant_clause");
+  REQUIRE_VALID_OR_SOLVING_STATE ();
+  REQUIRE (lits || !size, "can not import zero clause");
+  REQUIRE (size <= (size_t) INT_MAX, "imported clause too large");
+  for (size_t i = 0; i < size; i++)
+    REQUIRE_VALID_LIT (lits[i]);
+  external->import_redundant_clause (lits, size, glue);
+  LOG_API_CALL_END ("import_redundant_clause");
+}
+
 /*===== IPASIR END =======================================================*/
 
 /*===== IPASIR-UP BEGIN ==================================================*/
@@ -835,6 +873,7 @@ void Solver::connect_external_propagator (ExternalPropagator *propagator) {
   internal->connect_propagator ();
   internal->external_prop = true;
   internal->external_prop_is_lazy = propagator->is_lazy;
+  internal->external_prop_is_batched = propagator->is_batched;
   LOG_API_CALL_END ("connect_external_propagator");
 }
 
@@ -855,6 +894,7 @@ void Solver::disconnect_external_propagator () {
   internal->set_tainted_literal ();
   internal->external_prop = false;
   internal->external_prop_is_lazy = true;
+  internal->external_prop_is_batched = false;
   LOG_API_CALL_END ("disconnect_external_propagator");
 }
 
@@ -907,6 +947,27 @@ int64_t Solver::irredundant () const {
   return res;
 }
 
+int64_t Solver::get_statistic_value (const char *name) const {
+  REQUIRE_VALID_STATE ();
+  REQUIRE (name, "zero statistic name");
+  const Stats &stats = internal->stats;
+  int64_t res = -1;
+  if (!strcmp (name, "conflicts"))
+    res = stats.conflicts;
+  else if (!strcmp (name, "decisions"))
+    res = stats.decisions;
+  else if (!strcmp (name, "propagations"))
+    res = stats.propagations.search;
+  else if (!strcmp (name, "exported"))
+    res = stats.shared.exported;
+  else if (!strcmp (name, "imported"))
+    res = stats.shared.imported;
+  else if (!strcmp (name, "unexplained"))
+    res = stats.ext_prop.eprop_unexplained;
+  LOG_API_CALL_RETURNS ("get_statistic_value", res);
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 void Solver::freeze (int lit) {
@@ -175,6 +175,10 @@ void Stats::print (Internal *internal) {
     PRT ("  explained:     %15" PRId64 "   %10.2f %%  per eprop-call",
          stats.ext_prop.eprop_expl,
          percent (stats.ext_prop.eprop_expl, stats.ext_prop.eprop_call));
+    PRT ("  unexplained:   %15" PRId64 "   %10.2f %%  per eprop-call",
+         stats.ext_prop.eprop_unexplained,
+         percent (stats.ext_prop.eprop_unexplained,
+                  stats.ext_prop.eprop_call));
     PRT ("  falsified:     %15" PRId64 "   %10.2f %%  per eprop-call",
          stats.ext_prop.eprop_conf,
          percent (stats.ext_prop.eprop_conf, stats.ext_prop.eprop_call));
@@ -212,8 +216,13 @@ void Stats::print (Internal *internal) {
     PRT ("  probingrounds: %15" PRId64 "   %10.2f    per phase",
          stats.probingrounds,
          relative (stats.probingrounds, stats.probingphases));
+    PRT ("  bingraphs:     %15" PRId64 "   %10.2f    per phase",
+         stats.bingraphs, relative (stats.bingraphs, stats.probingphases));
     PRT ("  probed:        %15" PRId64 "   %10.2f    per failed",
          stats.probed, relative (stats.probed, stats.failed));
+    PRT ("  probetrees:    %15" PRId64 "   %10.2f    probed per tree",
+         stats.probetrees,
+         relative (stats.probetreed + stats.probetrees, stats.probetrees));
     PRT ("  hbrs:          %15" PRId64 "   %10.2f    per probed",
          stats.hbrs, relative (stats.hbrs, stats.probed));
     PRT ("  hbrsizes:      %15" PRId64 "   %10.2f    per hbr",
@@ -315,6 +324,15 @@ void Stats::print (Internal *internal) {
          percent (stats.otfs.strengthened, stats.conflicts));
   }
 
+  if (stats.proof.blocks) {
+    PRT ("proofblocks:     %15" PRId64 "   %10.2f MB per block",
+         stats.proof.blocks,
+         relative (stats.proof.bytes / (double) (1 << 20),
+                   stats.proof.blocks));
+    PRT ("  blocked:       %15.2f   %10.2f %%  of solving time",
+         stats.proof.blocked, percent (stats.proof.blocked, t));
+  }
+
   PRT ("propagations:    %15" PRId64 "   %10.2f M  per second",
        propagations, relative (propagations / 1e6, t));
   PRT ("  coverprops:    %15" PRId64 "   %10.2f %%  of propagations",
@@ -352,6 +370,13 @@ void Stats::print (Internal *internal) {
          stats.reductions, relative (stats.conflicts, stats.reductions));
     PRT ("  collections:   %15" PRId64 "   %10.2f    interval",
          stats.collections, relative (stats.conflicts, stats.collections));
+    PRT ("  arenamajor:    %15" PRId64 "   %10.2f %%  of collections",
+         stats.arena.major, percent (stats.arena.major, stats.collections));
+    PRT ("  arenaminor:    %15" PRId64 "   %10.2f %%  of collections",
+         stats.arena.minor, percent (stats.arena.minor, stats.collections));
+    PRT ("  arenamoved:    %15" PRId64 "   %10.2f    per collection",
+         stats.arena.moved,
+         relative (stats.arena.moved, stats.collections));
   }
   if (all || stats.rephased.total) {
     PRT ("rephased:        %15" PRId64 "   %10.2f    interval",
@@ -397,6 +422,21 @@ void Stats::print (Internal *internal) {
     PRT ("  literals:      %15" PRId64 "   %10.2f    per restored clause",
          stats.restoredlits, relative (stats.restoredlits, stats.restored));
   }
+  if (all || stats.shared.exported || stats.shared.imported) {
+    PRT ("shared:          %15" PRId64 "   %10.2f    per conflict",
+         stats.shared.exported,
+         relative (stats.shared.exported, stats.conflicts));
+    PRT ("  imported:      %15" PRId64 "   %10.2f    per conflict",
+         stats.shared.imported,
+         relative (stats.shared.imported, stats.conflicts));
+    PRT ("  units:         %15" PRId64 "   %10.2f %%  per imported",
+         stats.shared.units,
+         percent (stats.shared.units, stats.shared.imported));
+    PRT ("  dropped:       %15" PRId64 "   %10.2f %%  per imported",
+         stats.shared.dropped,
+         percent (stats.shared.dropped,
+                  stats.shared.imported + stats.shared.dropped));
+  }
   if (all || stats.stabphases) {
     PRT ("stabilizing:     %15" PRId64 "   %10.2f %%  of conflicts",
          stats.stabphases, percent (stats.stabconflicts, stats.conflicts));
@@ -440,6 +480,8 @@ void Stats::print (Internal *internal) {
          stats.subchecks, relative (stats.subchecks, stats.subtried));
     PRT ("  subchecks2:    %15" PRId64 "   %10.2f %%  per subcheck",
          stats.subchecks2, percent (stats.subchecks2, stats.subchecks));
+    PRT ("  subfiltered:   %15" PRId64 "   %10.2f    per subcheck",
+         stats.subfiltered, relative (stats.subfiltered, stats.subchecks));
     PRT ("  elimotfsub:    %15" PRId64 "   %10.2f %%  of subsumed",
          stats.elimotfsub, percent (stats.elimotfsub, stats.subsumed));
     PRT ("  elimbwsub:     %15" PRId64 "   %10.2f %%  of subsumed",
@@ -485,6 +527,15 @@ void Stats::print (Internal *internal) {
          percent (stats.vivifyunits, stats.vivifychecks));
     PRT ("  vivifyinst:    %15" PRId64 "   %10.2f %%  per vivify check",
          stats.vivifyinst, percent (stats.vivifyinst, stats.vivifychecks));
+    PRT ("  vivparchks:    %15" PRId64 "   %10.2f    per vivification",
+         stats.vivifyparchks,
+         relative (stats.vivifyparchks, stats.vivifications));
+    PRT ("  vivparskip:    %15" PRId64 "   %10.2f %%  per parallel check",
+         stats.vivifyparskip,
+         percent (stats.vivifyparskip, stats.vivifyparchks));
+    PRT ("  vivparprops:   %15" PRId64 "   %10.2f    per parallel check",
+         stats.vivifyparprops,
+         relative (stats.vivifyparprops, stats.vivifyparchks));
     PRT ("  vivifysubs:    %15" PRId64 "   %10.2f %%  per subsumed",
          stats.vivifysubs, percent (stats.vivifysubs, stats.subsumed));
     PRT ("  vivifystrs:    %15" PRId64 "   %10.2f %%  per strengthened",
@@ -554,6 +605,13 @@ void Internal::print_resource_usage () {
        internal->real_time ());
   MSG ("maximum resident set size of process:    %12.2f    MB",
        m / (double) (1l << 20));
+  if (opts.arenahuge) {
+    uint64_t h = huge_pages_resident_set_size ();
+    MSG ("arena memory mapped for huge pages:      %12.2f    MB",
+         arena.huge_bytes () / (double) (1l << 20));
+    MSG ("resident memory backed by huge pages:    %12.2f    MB",
+         h / (double) (1l << 20));
+  }
 #endif
 }
 
@@ -587,4 +645,36 @@ void Checker::print_stats () {
   MSG ("units:           %15" PRId64 "", stats.units);
 }
 
+/*------------------------------------------------------------------------*/
+
+void LratChecker::print_stats () {
+
+  // With '--checkproofthread' the statistics are updated by the checker
+  // thread, thus we have to wait until it processed all steps.
+  //
+  wait ();
+
+  if (!stats.added && !stats.deleted)
+    return;
+
+  SECTION ("lrat checker statistics");
+
+  MSG ("checks:          %15" PRId64 "", stats.checks);
+  MSG ("original:        %15" PRId64 "   %10.2f %%  of all clauses",
+       stats.original, percent (stats.original, stats.added));
+  MSG ("derived:         %15" PRId64 "   %10.2f %%  of all clauses",
+       stats.derived, percent (stats.derived, stats.added));
+  MSG ("deleted:         %15" PRId64 "   %10.2f %%  of all clauses",
+       stats.deleted, percent (stats.deleted, stats.added));
+  MSG ("finalized:       %15" PRId64 "   %10.2f %%  of all clauses",
+       stats.finalized, percent (stats.finalized, stats.added));
+  MSG ("insertions:      %15" PRId64 "   %10.2f %%  of all clauses",
+       stats.insertions, percent (stats.insertions, stats.added));
+  MSG ("collections:     %15" PRId64 "   %10.2f    deleted per collection",
+       stats.collections, relative (stats.deleted, stats.collections));
+  MSG ("collisions:      %15" PRId64 "   %10.2f    per search",
+       stats.collisions, relative (stats.collisions, stats.searches));
+  MSG ("searches:        %15" PRId64 "", stats.searches);
+}
+
 } // namespace CaDiCaL
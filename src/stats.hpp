@@ -35,6 +35,7 @@ struct Stats {
     int64_t
         eprop_conf; // number of times ex-propagate was already falsified
     int64_t eprop_expl; // number of times external propagate was explained
+    int64_t eprop_unexplained; // explanations avoided below conflict level
     int64_t
         elearn_call;  // number of times external clause learning was tried
     int64_t elearned; // learned external clauses (incl. eprop explanations)
@@ -75,6 +76,12 @@ struct Stats {
     double process, real;
   } time;
 
+  struct {
+    int64_t major; // major collections evacuating the whole arena
+    int64_t minor; // minor collections evacuating only young clauses
+    int64_t moved; // number of bytes moved into the arena
+  } arena;
+
   struct {
     int64_t count;      // number of covered clause elimination rounds
     int64_t asymmetric; // number of asymmetric tautologies in CCE
@@ -110,6 +117,19 @@ struct Stats {
     int64_t minimum;
   } walk;
 
+  struct {
+    int64_t exported; // exported shared clauses (including units)
+    int64_t imported; // imported shared clauses (including units)
+    int64_t units;    // imported shared units
+    int64_t dropped;  // dropped imported clauses with inactive variables
+  } shared;
+
+  struct {
+    int64_t blocks; // proof blocks written
+    int64_t bytes;  // proof bytes written
+    double blocked; // time waiting for the proof writer
+  } proof;
+
   struct {
     int64_t count;   // flushings of learned clauses counter
     int64_t learned; // flushed learned clauses
@@ -159,6 +179,7 @@ struct Stats {
   int64_t subtried;  // number of tried subsumptions
   int64_t subchecks; // number of pair-wise subsumption checks
   int64_t subchecks2;    // same but restricted to binary clauses
+  int64_t subfiltered;   // pairs filtered by signatures before checking
   int64_t elimotfsub;    // number of on-the-fly subsumed during elimination
   int64_t subsumerounds; // number of subsumption rounds
   int64_t subsumephases; // number of scheduled subsumption phases
@@ -197,6 +218,9 @@ struct Stats {
   int64_t vivifystred3;   // strengthened redundant clause (3)
   int64_t vivifyunits;    // units during vivification
   int64_t vivifyinst;     // instantiation during vivification
+  int64_t vivifyparchks;  // candidates checked in parallel
+  int64_t vivifyparskip;  // candidates skipped after parallel check
+  int64_t vivifyparprops; // propagations of parallel checkers
   int64_t transreds;
   int64_t transitive;
   struct {
@@ -217,8 +241,11 @@ struct Stats {
   int64_t binaries;      // learned binary clauses
   int64_t probingphases; // number of scheduled probing phases
   int64_t probingrounds; // number of probing rounds
+  int64_t bingraphs;     // rebuilt binary implication graphs
   int64_t probesuccess;  // number successful probing phases
   int64_t probed;        // number of probed literals
+  int64_t probetrees;    // number of probe tree roots
+  int64_t probetreed;    // probed on top of other probe tree roots
   int64_t failed;        // number of failed literals
   int64_t hyperunary;    // hyper unary resolved unit clauses
   int64_t probefailed;   // failed literals from probing
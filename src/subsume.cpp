@@ -142,6 +142,21 @@ inline int Internal::subsume_check (Clause *subsuming, Clause *subsumed) {
 
 /*------------------------------------------------------------------------*/
 
+// Each connected clause gets a 64-bit signature of its variables (not
+// literals, since strengthening flips one literal), kept in an array
+// parallel to its (one-watch) occurrence list.  A clause can only subsume
+// or strengthen a candidate if its signature is contained in the signature
+// of the candidate, which allows to filter most pairs before marking.
+
+inline static uint64_t subsume_signature (const Clause *c) {
+  uint64_t res = 0;
+  for (const auto &lit : *c)
+    res |= (uint64_t) 1 << (abs (lit) & 63);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Candidate clause 'subsumed' is subsumed by 'subsuming'.
 
 inline void Internal::subsume_clause (Clause *subsuming, Clause *subsumed) {
@@ -200,14 +215,16 @@ void Internal::strengthen_clause (Clause *c, int lit) {
 // strengthened the result is negative.  Otherwise the candidate clause
 // can not be subsumed nor strengthened and zero is returned.
 
-inline int Internal::try_to_subsume_clause (Clause *c,
-                                            vector<Clause *> &shrunken) {
+inline int
+Internal::try_to_subsume_clause (Clause *c, vector<Clause *> &shrunken,
+                                 const vector<vector<uint64_t>> &sigs) {
 
   stats.subtried++;
   assert (!level);
   LOG (c, "trying to subsume");
 
   mark (c); // signed!
+  const uint64_t signature = subsume_signature (c);
 
   Clause dummy; // Communicate binary subsuming clause.
 
@@ -274,16 +291,33 @@ inline int Internal::try_to_subsume_clause (Clause *c,
       // as above for communicating 'subsumption' or 'strengthening' to the
       // code after the loop is used.
       //
+      // The signatures are filtered in blocks of eight first, which is
+      // branch-free and can thus be vectorized by the compiler.  Only the
+      // remaining clauses are checked with 'subsume_check'.
+      //
       const Occs &os = occs (sign * lit);
-      for (const auto &e : os) {
-        assert (!e->garbage); // sanity check
-        if (e->garbage)
-          continue; // defensive: not needed
-        flipped = subsume_check (e, c);
-        if (!flipped)
-          continue;
-        d = e; // leave also outer loop
-        break;
+      const uint64_t *ss = sigs[vlit (sign * lit)].data ();
+      const size_t size = os.size ();
+      for (size_t i = 0; !d && i < size; i += 8) {
+        const size_t end = min (size, i + 8);
+        unsigned candidates = 0;
+        for (size_t j = i; j < end; j++)
+          candidates |= (unsigned) !(ss[j] & ~signature) << (j - i);
+        stats.subfiltered += end - i;
+        for (size_t j = i; candidates; j++, candidates >>= 1) {
+          if (!(candidates & 1))
+            continue;
+          stats.subfiltered--;
+          Clause *e = os[j];
+          assert (!e->garbage); // sanity check
+          if (e->garbage)
+            continue; // defensive: not needed
+          flipped = subsume_check (e, c);
+          if (!flipped)
+            continue;
+          d = e; // leave also outer loop
+          break;
+        }
       }
     }
 
@@ -481,6 +515,7 @@ bool Internal::subsume_round () {
   int64_t subsumed = 0, strengthened = 0, checked = 0;
 
   vector<Clause *> shrunken;
+  vector<vector<uint64_t>> sigs (2 * (size_t) (max_var + 1));
   init_occs ();
   init_bins ();
 
@@ -506,7 +541,7 @@ bool Internal::subsume_round () {
     //
     if (c->size > 2 && c->subsume) {
       c->subsume = false;
-      const int tmp = try_to_subsume_clause (c, shrunken);
+      const int tmp = try_to_subsume_clause (c, shrunken, sigs);
       if (tmp > 0) {
         subsumed++;
         continue;
@@ -572,6 +607,7 @@ bool Internal::subsume_round () {
       // not take benefit of this sorting optimization.
       //
       sort (c->begin (), c->end (), subsume_less_noccs (this));
+      sigs[vlit (minlit)].push_back (subsume_signature (c));
 
     } else {
 
@@ -612,6 +648,7 @@ bool Internal::subsume_round () {
   // Release occurrence lists and schedule.
   //
   erase_vector (schedule);
+  erase_vector (sigs);
   reset_noccs ();
   reset_occs ();
   reset_bins ();
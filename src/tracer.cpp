@@ -7,13 +7,22 @@ namespace CaDiCaL {
 Tracer::Tracer (Internal *i, File *f, bool b, bool lrat, bool frat,
                 bool veripb)
     : internal (i), file (f), binary (b), lrat (lrat), frat (frat),
-      veripb (veripb), added (0), deleted (0), latest_id (0) {
-  (void) internal;
+      veripb (veripb), added (0), deleted (0), latest_id (0),
+      trim (false), trimmed (false), spill (0), empty_step (-1) {
   LOG ("TRACER new");
+  if (lrat && !frat && !veripb && internal->opts.lrattrim) {
+    spill = tmpfile ();
+    if (spill)
+      trim = true;
+    else
+      WARNING ("failed to open temporary file to trim LRAT proof");
+  }
 }
 
 Tracer::~Tracer () {
   LOG ("TRACER delete");
+  if (spill)
+    fclose (spill);
   delete file;
 }
 
@@ -61,33 +70,51 @@ inline void Tracer::put_binary_id (uint64_t id) {
 
 /*------------------------------------------------------------------------*/
 
+void Tracer::lrat_write_deletions (uint64_t id,
+                                   const vector<uint64_t> &ids) {
+  // if (binary) put_binary_id (latest_id);
+  // if (binary) file->put ('d');
+  if (!binary)
+    file->put (id), file->put (" ");
+  if (binary)
+    file->put ('d');
+  else
+    file->put ("d ");
+  for (auto &did : ids) {
+    if (binary)
+      put_binary_id (2 * did); // to have the output format as drat-trim
+    else
+      file->put (did), file->put (" ");
+  }
+  if (binary)
+    put_binary_zero ();
+  else
+    file->put ("0\n");
+}
+
 void Tracer::lrat_add_clause (uint64_t id, const vector<int> &clause,
                               const vector<uint64_t> &chain) {
   LOG ("TRACER LRAT tracing addition of derived clause with proof chain");
 
   if (delete_ids.size ()) {
-    // if (binary) put_binary_id (latest_id);
-    // if (binary) file->put ('d');
-    if (!binary)
-      file->put (latest_id), file->put (" ");
-    if (binary)
-      file->put ('d');
-    else
-      file->put ("d ");
-    for (auto &did : delete_ids) {
-      if (binary)
-        put_binary_id (2 * did); // to have the output format as drat-trim
-      else
-        file->put (did), file->put (" ");
-    }
-    if (binary)
-      put_binary_zero ();
+    if (trim)
+      lrat_spill ('d', latest_id, vector<int> (), delete_ids);
     else
-      file->put ("0\n");
+      lrat_write_deletions (latest_id, delete_ids);
     delete_ids.clear ();
   }
   latest_id = id;
 
+  if (trim) {
+    if (clause.empty () && empty_step < 0)
+      empty_step = steps.size ();
+    lrat_spill ('a', id, clause, chain);
+  } else
+    lrat_write_clause (id, clause, chain);
+}
+
+void Tracer::lrat_write_clause (uint64_t id, const vector<int> &clause,
+                                const vector<uint64_t> &chain) {
   if (binary)
     file->put ('a'), put_binary_id (id);
   else
@@ -119,6 +146,163 @@ void Tracer::lrat_delete_clause (uint64_t id) {
 
 /*------------------------------------------------------------------------*/
 
+// Trimming LRAT proofs.  Derived clauses and deletions are spilled to a
+// temporary file in the order they are traced.  As soon the empty clause
+// is derived and the proof is flushed or closed, we go backward over the
+// spilled steps starting at the empty clause and collect the identifiers
+// of all clauses used in a proof chain of a needed clause.  A second
+// forward pass then only writes the needed clauses.  Each clause is
+// deleted right after the step in which it is used for the last time
+// (which we know from the backward pass too).  If the empty clause is
+// never derived all steps are written unchanged when closing the proof.
+// The backward pass reads the spilled steps in large blocks, since seeking
+// to every single step would refill the buffer of 'spill' for each step.
+// After trimming the proof already ends with the empty clause.  Steps
+// traced later are not needed and thus dropped (they might even refer to
+// clauses which were trimmed away).
+
+void Tracer::lrat_spill (char type, uint64_t id, const vector<int> &clause,
+                         const vector<uint64_t> &chain) {
+  assert (trim);
+  if (trimmed) {
+    assert (empty_step >= 0);
+    return;
+  }
+  steps.push_back (ftello (spill));
+  const uint64_t header[4] = {(uint64_t) type, id, clause.size (),
+                              chain.size ()};
+  fwrite (header, sizeof header, 1, spill);
+  if (!clause.empty ())
+    fwrite (clause.data (), sizeof (int), clause.size (), spill);
+  if (!chain.empty ())
+    fwrite (chain.data (), sizeof (uint64_t), chain.size (), spill);
+}
+
+char Tracer::lrat_read (uint64_t &id, vector<int> &clause,
+                        vector<uint64_t> &chain) {
+  uint64_t header[4];
+  if (fread (header, sizeof header, 1, spill) != 1)
+    return 0;
+  id = header[1];
+  clause.resize (header[2]);
+  chain.resize (header[3]);
+  if (!clause.empty () &&
+      fread (clause.data (), sizeof (int), clause.size (), spill) !=
+          clause.size ())
+    return 0;
+  if (!chain.empty () &&
+      fread (chain.data (), sizeof (uint64_t), chain.size (), spill) !=
+          chain.size ())
+    return 0;
+  return (char) header[0];
+}
+
+// Same as 'lrat_read' but decodes a step from a block of spilled steps.
+
+static char lrat_decode (const char *p, uint64_t &id, vector<int> &clause,
+                         vector<uint64_t> &chain) {
+  uint64_t header[4];
+  memcpy (header, p, sizeof header);
+  p += sizeof header;
+  id = header[1];
+  clause.resize (header[2]);
+  chain.resize (header[3]);
+  if (!clause.empty ())
+    memcpy (clause.data (), p, clause.size () * sizeof (int));
+  p += clause.size () * sizeof (int);
+  if (!chain.empty ())
+    memcpy (chain.data (), p, chain.size () * sizeof (uint64_t));
+  return (char) header[0];
+}
+
+// Size of blocks read at once in the backward pass of trimming.
+
+static const int64_t lrat_trim_block = 1 << 22;
+
+void Tracer::lrat_trim () {
+  assert (trim);
+  assert (!trimmed);
+  trimmed = true;
+  fflush (spill);
+  const int64_t end = ftello (spill);
+
+  vector<int> clause;
+  vector<uint64_t> chain;
+  uint64_t id;
+
+  const int64_t size = steps.size ();
+  int64_t written = 0, derived = 0;
+
+  if (empty_step < 0) {
+    fseeko (spill, 0, SEEK_SET);
+    for (int64_t i = 0; i < size; i++) {
+      const char type = lrat_read (id, clause, chain);
+      if (type == 'a')
+        lrat_write_clause (id, clause, chain), written++, derived++;
+      else if (type == 'd')
+        lrat_write_deletions (id, chain);
+      else
+        break;
+    }
+  } else {
+    unordered_set<uint64_t> used;
+    vector<pair<int64_t, uint64_t>> last;
+    vector<char> block;
+    int64_t i = empty_step;
+    while (i >= 0) {
+      // Read as many steps up to step 'i' as fit into one block, but at
+      // least step 'i' itself (which might be larger than a block).
+      const int64_t to = i + 1 < size ? steps[i + 1] : end;
+      int64_t j = i;
+      while (j > 0 && to - steps[j - 1] <= lrat_trim_block)
+        j--;
+      const int64_t from = steps[j];
+      block.resize (to - from);
+      if (fseeko (spill, from, SEEK_SET) ||
+          fread (block.data (), 1, block.size (), spill) != block.size ())
+        FATAL ("failed to read back spilled LRAT proof steps");
+      for (; i >= j; i--) {
+        const char *p = block.data () + (steps[i] - from);
+        if (lrat_decode (p, id, clause, chain) != 'a')
+          continue;
+        derived++;
+        if (i != empty_step && !used.count (id))
+          continue;
+        for (const auto &c : chain)
+          if (used.insert (c).second)
+            last.push_back ({i, c});
+      }
+    }
+    erase_vector (block);
+    fseeko (spill, 0, SEEK_SET);
+    auto l = last.rbegin ();
+    vector<uint64_t> ids;
+    for (int64_t i = 0; i <= empty_step; i++) {
+      if (lrat_read (id, clause, chain) != 'a')
+        continue;
+      if (i != empty_step && !used.count (id))
+        continue;
+      lrat_write_clause (id, clause, chain);
+      written++;
+      ids.clear ();
+      while (l != last.rend () && l->first == i)
+        ids.push_back (l->second), l++;
+      if (i != empty_step && !ids.empty ())
+        lrat_write_deletions (id, ids);
+    }
+  }
+
+  MSG ("trimmed LRAT proof to %" PRId64 " of %" PRId64
+       " derived clauses (%.0f%%)",
+       written, derived, percent (written, derived));
+
+  fclose (spill);
+  spill = 0;
+  erase_vector (steps);
+}
+
+/*------------------------------------------------------------------------*/
+
 void Tracer::frat_add_original_clause (uint64_t id,
                                        const vector<int> &clause) {
   LOG ("TRACER FRAT tracing addition of original clause");
@@ -393,16 +577,33 @@ void Tracer::set_first_id (uint64_t id) {
 
 bool Tracer::closed () { return file->closed (); }
 
+// Statistics on writing proof blocks (see 'File::buffer').
+
+void Tracer::update_stats () {
+  internal->stats.proof.blocks = file->blocks ();
+  internal->stats.proof.bytes = file->bytes ();
+  internal->stats.proof.blocked = file->blocked ();
+}
+
 void Tracer::close () {
   assert (!closed ());
+  if (trim && !trimmed)
+    lrat_trim ();
   file->close ();
+  update_stats ();
 }
 
 void Tracer::flush () {
   assert (!closed ());
+  if (trim && !trimmed && empty_step >= 0)
+    lrat_trim ();
   file->flush ();
+  update_stats ();
   MSG ("traced %" PRId64 " added and %" PRId64 " deleted clauses", added,
        deleted);
+  if (file->blocks ())
+    MSG ("waited %.2f seconds for writing %" PRIu64 " proof blocks",
+         file->blocked (), file->blocks ());
 }
 
 } // namespace CaDiCaL
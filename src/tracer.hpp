@@ -27,6 +27,22 @@ class Tracer {
   void lrat_add_clause (uint64_t, const vector<int> &,
                         const vector<uint64_t> &);
   void lrat_delete_clause (uint64_t);
+  void lrat_write_clause (uint64_t, const vector<int> &,
+                          const vector<uint64_t> &);
+  void lrat_write_deletions (uint64_t, const vector<uint64_t> &);
+
+  // support trimming LRAT proofs ('lrattrim'), where steps are first
+  // spilled to a temporary file and only the clauses needed to derive the
+  // empty clause are written in the end
+  bool trim;
+  bool trimmed;            // trimmed proof already written
+  FILE *spill;             // spilled proof steps
+  vector<int64_t> steps;   // offsets of spilled proof steps
+  int64_t empty_step;      // first step deriving the empty clause
+  void lrat_spill (char type, uint64_t, const vector<int> &,
+                   const vector<uint64_t> &);
+  char lrat_read (uint64_t &, vector<int> &, vector<uint64_t> &);
+  void lrat_trim ();
 
   // support FRAT
   void frat_add_original_clause (uint64_t, const vector<int> &);
@@ -46,6 +62,8 @@ class Tracer {
   void drat_add_clause (const vector<int> &);
   void drat_delete_clause (const vector<int> &);
 
+  void update_stats ();
+
 public:
   // own and delete 'file'
   Tracer (Internal *, File *file, bool binary, bool lrat, bool frat,
@@ -68,10 +68,11 @@ void Internal::transred () {
     i = clauses.begin ();
   }
 
-  // Move watches of binary clauses to the front. Thus we can stop iterating
-  // watches as soon a long clause is found during watch traversal.
+  // Traverse the binary implication graph snapshot.  Removing transitive
+  // clauses invalidates it, but it stays allocated and removed clauses are
+  // skipped below, since they are marked as garbage.
   //
-  sort_watches ();
+  update_bin_graph ();
 
   // This working stack plays the same role as the 'trail' during standard
   // propagation.
@@ -106,13 +107,13 @@ void Internal::transred () {
     // Find a different path from 'src' to 'dst' in the binary implication
     // graph, not using 'c'.  Since this is the same as checking whether
     // there is a path from '-dst' to '-src', we can do the reverse search
-    // if the number of watches of '-dst' is larger than those of 'src'.
+    // if the number of edges of '-dst' is larger than those of 'src'.
     //
     int src = -c->literals[0];
     int dst = c->literals[1];
     if (val (src) || val (dst))
       continue;
-    if (watches (-src).size () < watches (dst).size ()) {
+    if (bin_edges (-src).size () < bin_edges (dst).size ()) {
       int tmp = dst;
       dst = -src;
       src = -tmp;
@@ -147,21 +148,18 @@ void Internal::transred () {
       assert (marked (lit) > 0);
       LOG ("transred propagating %d", lit);
       propagations++;
-      const Watches &ws = watches (-lit);
-      const const_watch_iterator eow = ws.end ();
-      const_watch_iterator k;
-      for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
-        const Watch &w = *k;
-        if (!w.binary ())
-          break; // since we sorted watches above
-        Clause *d = w.clause;
+      const BinEdges edges = bin_edges (-lit);
+      const BinEdge *eoe = edges.end ();
+      const BinEdge *k;
+      for (k = edges.begin (); !transitive && !failed && k != eoe; k++) {
+        Clause *d = k->clause;
         if (d == c)
           continue;
         if (irredundant && d->redundant)
           continue;
         if (d->garbage)
           continue;
-        const int other = w.blit;
+        const int other = k->lit;
         if (other == dst)
           transitive = true; // 'dst' reached
         else {
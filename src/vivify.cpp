@@ -1,5 +1,13 @@
 #include "internal.hpp"
 
+#include <atomic>
+
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
@@ -139,11 +147,13 @@ bool Internal::vivify_propagate () {
           literal_iterator k = middle;
           signed char v = -1;
           int r = 0;
+          k = skip_false_literals (k, end);
           while (k != end && (v = val (r = *k)) < 0)
             k++;
           if (v < 0) {
             k = lits + 2;
             assert (w.clause->pos <= size);
+            k = skip_false_literals (k, middle);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
@@ -1068,6 +1078,347 @@ inline void Internal::vivify_chain_for_units (int lit, Clause *reason) {
 
 /*------------------------------------------------------------------------*/
 
+// With 'vivifypar' candidates are first checked in blocks by worker
+// threads, which only have read access to a frozen snapshot of the watched
+// clauses and use their own assignment and trail.  Vivification fails for
+// most candidates, and a worker check which neither finds an implied
+// literal, a falsified literal nor a conflict (including instantiation of
+// the last literal) shows that 'vivify_clause' would not find anything
+// either.  Only the remaining candidates are vivified by the main thread,
+// which re-validates them on the current watches and derives the LRAT
+// chains as before.  Units found in the mean time are not part of the
+// snapshot, which might only miss a few vivifications.  As blocks are
+// checked completely before they are vivified in schedule order, the
+// result only depends on the number of threads through the effort limit,
+// which is charged with the checker propagations per thread.  Every thread
+// has its own assignment and counters for all snapshot clauses, thus the
+// number of threads ('vivifyparjobs') defaults to one.  The threads are
+// started once per round and wait for the next block in between.
+
+struct VivifySnapshot {
+  vector<signed char> root;              // root-level values by 'vlit'
+  vector<unsigned> start;                // clause 'i' is 'start[i..i+1]'
+  vector<int> lits;                      // non-false clause literals
+  vector<unsigned> offsets;              // occurrences by 'vlit'
+  vector<unsigned> occs;                 // of snapshot clauses
+  vector<pair<Clause *, unsigned>> index; // sorted by clause address
+
+  VivifySnapshot (Internal *, bool redundant_mode);
+};
+
+VivifySnapshot::VivifySnapshot (Internal *internal, bool redundant_mode) {
+  assert (!internal->level);
+  const size_t vlits = 2 * (size_t) internal->max_var + 2;
+  root.resize (vlits, 0);
+  for (auto idx : internal->vars) {
+    const signed char tmp = internal->val (idx);
+    root[internal->vlit (idx)] = tmp;
+    root[internal->vlit (-idx)] = -tmp;
+  }
+  offsets.resize (vlits + 1, 0);
+  for (const auto &c : internal->clauses) {
+    if (c->garbage || (!redundant_mode && c->redundant))
+      continue;
+    const size_t begin = lits.size ();
+    bool satisfied = false;
+    for (const auto &lit : *c) {
+      const signed char tmp = root[internal->vlit (lit)];
+      if (tmp > 0) {
+        satisfied = true;
+        break;
+      }
+      if (!tmp)
+        lits.push_back (lit);
+    }
+    if (satisfied || lits.size () - begin < 2) {
+      lits.resize (begin);
+      continue;
+    }
+    index.push_back ({c, (unsigned) start.size ()});
+    start.push_back (begin);
+    for (size_t i = begin; i < lits.size (); i++)
+      offsets[internal->vlit (lits[i])]++;
+  }
+  start.push_back (lits.size ());
+  unsigned sum = 0;
+  for (auto &offset : offsets) {
+    const unsigned count = offset;
+    offset = sum;
+    sum += count;
+  }
+  occs.resize (sum);
+  vector<unsigned> pos (offsets.begin (), offsets.end () - 1);
+  for (unsigned i = 0; i + 1 < start.size (); i++)
+    for (unsigned j = start[i]; j < start[i + 1]; j++)
+      occs[pos[internal->vlit (lits[j])]++] = i;
+  sort (index.begin (), index.end ());
+}
+
+struct VivifyChecker {
+  Internal *internal;
+  const VivifySnapshot *snapshot;
+  vector<signed char> vals;  // private assignment by 'vlit'
+  vector<unsigned> falsified; // propagated false literals per clause
+  vector<int> trail, sorted;
+  size_t propagated;
+  int64_t propagations;
+
+  VivifyChecker (Internal *i, const VivifySnapshot *s)
+      : internal (i), snapshot (s), vals (s->root),
+        falsified (s->start.size () - 1, 0), propagated (0),
+        propagations (0) {}
+
+  void assign (int lit) {
+    vals[internal->vlit (lit)] = 1;
+    vals[internal->vlit (-lit)] = -1;
+    trail.push_back (lit);
+  }
+  bool propagate (unsigned ignore);
+  void backtrack (size_t size);
+  bool check (Clause *);
+};
+
+// Counter based propagation (every falsified literal of a clause is
+// counted), which does not need to modify any shared clause data.  The
+// candidate 'ignore' is still counted to keep backtracking symmetric.
+
+bool VivifyChecker::propagate (unsigned ignore) {
+  const VivifySnapshot &s = *snapshot;
+  bool ok = true;
+  while (ok && propagated < trail.size ()) {
+    const int lit = trail[propagated++];
+    propagations++;
+    const unsigned not_lit = internal->vlit (-lit);
+    const unsigned end = s.offsets[not_lit + 1];
+    for (unsigned i = s.offsets[not_lit]; i < end; i++) {
+      const unsigned c = s.occs[i];
+      const unsigned count = ++falsified[c];
+      if (!ok || c == ignore)
+        continue;
+      const unsigned size = s.start[c + 1] - s.start[c];
+      if (count + 1 < size)
+        continue;
+      int unit = 0;
+      bool satisfied = false;
+      for (unsigned j = s.start[c]; j < s.start[c + 1]; j++) {
+        const int other = s.lits[j];
+        const signed char tmp = vals[internal->vlit (other)];
+        if (tmp > 0) {
+          satisfied = true;
+          break;
+        }
+        if (!tmp)
+          unit = other;
+      }
+      if (satisfied)
+        continue;
+      if (unit)
+        assign (unit);
+      else
+        ok = false;
+    }
+  }
+  return ok;
+}
+
+void VivifyChecker::backtrack (size_t size) {
+  const VivifySnapshot &s = *snapshot;
+  while (trail.size () > size) {
+    const int lit = trail.back ();
+    if (trail.size () <= propagated) {
+      const unsigned not_lit = internal->vlit (-lit);
+      for (unsigned i = s.offsets[not_lit]; i < s.offsets[not_lit + 1]; i++)
+        falsified[s.occs[i]]--;
+    }
+    trail.pop_back ();
+    vals[internal->vlit (lit)] = vals[internal->vlit (-lit)] = 0;
+  }
+  if (propagated > size)
+    propagated = size;
+}
+
+// Returns 'true' if 'vivify_clause' might vivify the candidate.
+
+bool VivifyChecker::check (Clause *c) {
+  const VivifySnapshot &s = *snapshot;
+  if (c->garbage)
+    return true;
+  const auto p = lower_bound (s.index.begin (), s.index.end (),
+                              pair<Clause *, unsigned> (c, 0));
+  if (p == s.index.end () || p->first != c)
+    return true;
+  const unsigned idx = p->second;
+  sorted.assign (s.lits.begin () + s.start[idx],
+                 s.lits.begin () + s.start[idx + 1]);
+  sort (sorted.begin (), sorted.end (), vivify_more_noccs (internal));
+  bool res = false;
+  size_t before = 0;
+  for (const auto &lit : sorted) {
+    if (vals[internal->vlit (lit)]) {
+      res = true;
+      break;
+    }
+    before = trail.size ();
+    assign (-lit);
+    if (!propagate (idx)) {
+      res = true;
+      break;
+    }
+  }
+  if (!res && internal->opts.vivifyinst) {
+    backtrack (before);
+    assign (sorted.back ());
+    res = !propagate (idx);
+  }
+  backtrack (0);
+  return res;
+}
+
+// The checkers of one round.  The first checker is used by the main
+// thread and every other checker by its own thread, which waits for the
+// next block to be started and signals when it has no more candidates.
+
+struct VivifyWorkers {
+  vector<VivifyChecker> checkers;
+  Vivifier *vivifier;
+  std::atomic<size_t> next; // next candidate in block to check
+#ifndef NTHREADS
+  vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake, done;
+  uint64_t blocks;  // number of started blocks
+  size_t running;   // threads still checking the current block
+  bool stop;
+  void run (size_t);
+#endif
+
+  VivifyWorkers (Internal *, const VivifySnapshot *, Vivifier *,
+                 size_t jobs);
+  ~VivifyWorkers ();
+
+  void work (VivifyChecker &);
+  void check ();
+};
+
+VivifyWorkers::VivifyWorkers (Internal *internal,
+                              const VivifySnapshot *snapshot,
+                              Vivifier *v, size_t jobs)
+    : vivifier (v), next (0) {
+  assert (jobs > 0);
+  for (size_t i = 0; i < jobs; i++)
+    checkers.push_back (VivifyChecker (internal, snapshot));
+#ifndef NTHREADS
+  blocks = 0;
+  running = 0;
+  stop = false;
+  for (size_t i = 1; i < jobs; i++)
+    threads.push_back (std::thread (&VivifyWorkers::run, this, i));
+#endif
+}
+
+VivifyWorkers::~VivifyWorkers () {
+#ifndef NTHREADS
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    stop = true;
+  }
+  wake.notify_all ();
+  for (auto &thread : threads)
+    thread.join ();
+#endif
+}
+
+void VivifyWorkers::work (VivifyChecker &checker) {
+  const auto &block = vivifier->block;
+  const size_t size = block.size ();
+  for (;;) {
+    const size_t i = next.fetch_add (1, std::memory_order_relaxed);
+    if (i >= size)
+      break;
+    vivifier->promising[i] = checker.check (block[i]);
+  }
+}
+
+#ifndef NTHREADS
+
+void VivifyWorkers::run (size_t i) {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      wake.wait (lock, [&] () { return stop || blocks != seen; });
+      if (stop)
+        return;
+      seen = blocks;
+    }
+    work (checkers[i]);
+    std::lock_guard<std::mutex> lock (mutex);
+    if (!--running)
+      done.notify_one ();
+  }
+}
+
+#endif
+
+// Check all candidates of the current block.
+
+void VivifyWorkers::check () {
+  next = 0;
+#ifndef NTHREADS
+  if (!threads.empty ()) {
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      running = threads.size ();
+      blocks++;
+    }
+    wake.notify_all ();
+  }
+#endif
+  work (checkers[0]);
+#ifndef NTHREADS
+  if (!threads.empty ()) {
+    std::unique_lock<std::mutex> lock (mutex);
+    done.wait (lock, [&] () { return !running; });
+  }
+#endif
+}
+
+// Check the next block of candidates from the back of the schedule.
+
+void Internal::vivify_check_block (Vivifier &vivifier,
+                                   VivifyWorkers &workers) {
+  auto &checkers = workers.checkers;
+  auto &schedule = vivifier.schedule;
+  auto &block = vivifier.block;
+  block.clear ();
+  const size_t max_size = 256 * checkers.size ();
+  while (block.size () < max_size && !schedule.empty ()) {
+    block.push_back (schedule.back ());
+    schedule.pop_back ();
+  }
+  const size_t size = block.size ();
+  stats.vivifyparchks += size;
+  vivifier.promising.assign (size, 0);
+  vivifier.next = 0;
+
+  LOG ("checking %zu vivification candidates with %zu threads", size,
+       checkers.size ());
+  workers.check ();
+
+  // Charge propagations per thread to keep the effort limit in terms of
+  // elapsed time.
+  //
+  int64_t propagations = 0;
+  for (auto &checker : checkers) {
+    propagations += checker.propagations;
+    checker.propagations = 0;
+  }
+  stats.vivifyparprops += propagations;
+  stats.propagations.vivify += propagations / checkers.size ();
+}
+
+/*------------------------------------------------------------------------*/
+
 // There are two modes of vivification, one using all clauses and one
 // focusing on irredundant clauses only.  The latter variant working on
 // irredundant clauses only can also remove irredundant asymmetric
@@ -1184,12 +1535,55 @@ void Internal::vivify_round (bool redundant_mode,
     learn_empty_clause ();
   }
 
+  VivifySnapshot *snapshot = 0;
+  VivifyWorkers *workers = 0;
+  if (!unsat && opts.vivifypar) {
+    size_t jobs = 1;
+#ifndef NTHREADS
+    jobs = opts.vivifyparjobs ? opts.vivifyparjobs
+                              : std::thread::hardware_concurrency ();
+    if (!jobs)
+      jobs = 1;
+#endif
+    PHASE ("vivify", stats.vivifications,
+           "parallel vivification with %zu threads", jobs);
+    snapshot = new VivifySnapshot (this, redundant_mode);
+    workers = new VivifyWorkers (this, snapshot, &vivifier, jobs);
+  }
+
+  auto &block = vivifier.block;
   while (!unsat && !terminated_asynchronously () &&
-         !vivifier.schedule.empty () && stats.propagations.vivify < limit) {
-    Clause *c = vivifier.schedule.back (); // Next candidate.
-    vivifier.schedule.pop_back ();
-    vivify_clause (vivifier, c);
+         (vivifier.next < block.size () || !vivifier.schedule.empty ()) &&
+         stats.propagations.vivify < limit) {
+    if (!snapshot) {
+      Clause *c = vivifier.schedule.back (); // Next candidate.
+      vivifier.schedule.pop_back ();
+      vivify_clause (vivifier, c);
+      continue;
+    }
+    if (vivifier.next == block.size ())
+      vivify_check_block (vivifier, *workers);
+    const size_t i = vivifier.next++;
+    Clause *c = block[i];
+    if (vivifier.promising[i])
+      vivify_clause (vivifier, c);
+    else {
+      c->vivify = false;
+      c->vivified = true;
+      stats.vivifychecks++;
+      stats.vivifyparskip++;
+    }
+  }
+
+  // Candidates of the last block which were not vivified go back to the
+  // schedule to be counted below.
+  //
+  while (vivifier.next < block.size ()) {
+    vivifier.schedule.push_back (block.back ());
+    block.pop_back ();
   }
+  delete workers;
+  delete snapshot;
 
   if (level)
     backtrack ();
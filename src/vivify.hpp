@@ -9,10 +9,20 @@ struct Vivifier {
   vector<Clause *> schedule, stack;
   vector<int> sorted;
   bool redundant_mode;
-  Vivifier (bool mode) : redundant_mode (mode) {}
+
+  // Block of candidates checked by 'vivifypar' threads, vivified in order
+  // starting at 'next' and skipped unless 'promising'.
+  //
+  vector<Clause *> block;
+  vector<signed char> promising;
+  size_t next;
+
+  Vivifier (bool mode) : redundant_mode (mode), next (0) {}
 
   void erase () {
     erase_vector (schedule);
+    erase_vector (block);
+    erase_vector (promising);
     erase_vector (sorted);
     erase_vector (stack);
   }
@@ -1,5 +1,11 @@
 #include "internal.hpp"
 
+#include <atomic>
+
+#ifndef NTHREADS
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
@@ -20,7 +26,62 @@ struct Walker {
 
   double score (unsigned); // compute score from break count
 
-  Walker (Internal *, double size, int64_t limit);
+  // With 'walkcounts' we do not use watches but a flat copy of the clauses
+  // with the number of true literals per clause and the exclusive or of
+  // these literals, which gives the single 'critical' true literal of a
+  // clause with one true literal.  The break values of the true literals
+  // and the set of unsatisfied clauses are then updated incrementally
+  // during flipping (as in 'ProbSAT' and 'YalSAT').
+
+  bool counting;
+  vector<int> lits;          // literals of all clauses
+  vector<size_t> starts;     // start of each clause in 'lits'
+  vector<size_t> occstarts;  // occurrence list offsets per literal
+  vector<unsigned> occs;     // clause occurrences of literals
+  vector<unsigned> counts;   // number of true literals per clause
+  vector<int> critical;      // exclusive or of true literals per clause
+  vector<unsigned> breaks;   // break value of true literal of variable
+  vector<unsigned> unsat;    // currently unsatisfied clauses
+  vector<unsigned> position; // position of unsatisfied clause in 'unsat'
+
+  // With 'walkjobs' larger than one additional helper walkers with their
+  // own seed, CB value and assignment run concurrently in counting mode.
+  // They share the (read-only) flat clauses of the main walker and just
+  // remember the best assignment they have found.
+
+  const Walker *shared;         // walker owning 'lits' and 'occs'
+  signed char *values;          // assignment ('internal->vals' for main)
+  vector<signed char> assigned; // own assignment of helper
+  vector<signed char> best;     // best assignment found by helper
+  int64_t minimum;              // unsatisfied clauses in 'best'
+  int64_t flips;                // flips of helper
+  vector<Walker *> helpers;     // helpers of main walker
+  std::atomic<bool> stop;       // asks helpers to stop
+#ifndef NTHREADS
+  vector<std::thread> threads; // running helpers
+#endif
+  void save_best ();
+
+  // Saving the phases of a new minimum only needs to update the variables
+  // flipped since the last saved minimum (if there are not too many).
+
+  bool saved;             // phases saved during this round
+  vector<int> flipped;    // variables flipped since then
+  void flip (int idx, int max_var) {
+    if (!saved)
+      return;
+    if (flipped.size () < (size_t) max_var)
+      flipped.push_back (idx);
+    else
+      saved = false, flipped.clear ();
+  }
+
+  size_t unsatisfied () const {
+    return counting ? unsat.size () : broken.size ();
+  }
+
+  Walker (Internal *, double size, int64_t limit, int id = 0);
+  ~Walker ();
 };
 
 // These are in essence the CB values from Adrian Balint's thesis.  They
@@ -60,16 +121,21 @@ inline static double fitcbval (double size) {
 
 // Initialize the data structures for one local search round.
 
-Walker::Walker (Internal *i, double size, int64_t l)
+Walker::Walker (Internal *i, double size, int64_t l, int id)
     : internal (i), random (internal->opts.seed), // global random seed
-      propagations (0), limit (l) {
+      propagations (0), limit (l), counting (internal->opts.walkcounts),
+      shared (this), values (internal->vals), minimum (0), flips (0),
+      stop (false), saved (false) {
   random += internal->stats.walk.count; // different seed every time
+  if (id)
+    random += id; // and for every helper
 
   // This is the magic constant in ProbSAT (also called 'CB'), which we pick
   // according to the average size every second invocation and otherwise
-  // just the default '2.0', which turns into the base '0.5'.
+  // just the default '2.0', which turns into the base '0.5'.  Helpers
+  // alternate between the two.
   //
-  const bool use_size_based_cb = (internal->stats.walk.count & 1);
+  const bool use_size_based_cb = ((internal->stats.walk.count + id) & 1);
   const double cb = use_size_based_cb ? fitcbval (size) : 2.0;
   assert (cb);
   const double base = 1 / cb; // scores are 'base^0,base^1,base^2,...
@@ -78,9 +144,15 @@ Walker::Walker (Internal *i, double size, int64_t l)
   for (epsilon = next; next; next = epsilon * base)
     table.push_back (epsilon = next);
 
-  PHASE ("walk", internal->stats.walk.count,
-         "CB %.2f with inverse %.2f as base and table size %zd", cb, base,
-         table.size ());
+  if (!id)
+    PHASE ("walk", internal->stats.walk.count,
+           "CB %.2f with inverse %.2f as base and table size %zd", cb, base,
+           table.size ());
+}
+
+Walker::~Walker () {
+  for (auto helper : helpers)
+    delete helper;
 }
 
 // The scores are tabulated for faster computation (to avoid 'pow').
@@ -91,6 +163,24 @@ inline double Walker::score (unsigned i) {
   return res;
 }
 
+// Helpers remember their best assignment and like the main walker only
+// need to copy the values of variables flipped since the last copy.
+
+void Walker::save_best () {
+  minimum = unsat.size ();
+  if (saved) {
+    for (auto idx : flipped)
+      best[idx] = values[idx];
+  } else {
+    const int max_var = internal->max_var;
+    best.resize (max_var + 1);
+    for (int idx = 1; idx <= max_var; idx++)
+      best[idx] = values[idx];
+    saved = true;
+  }
+  flipped.clear ();
+}
+
 /*------------------------------------------------------------------------*/
 
 Clause *Internal::walk_pick_clause (Walker &walker) {
@@ -249,6 +339,7 @@ void Internal::walk_flip_lit (Walker &walker, int lit) {
   const int idx = abs (lit);
   vals[idx] = tmp;
   vals[-idx] = -tmp;
+  walker.flip (idx, max_var);
   assert (val (lit) > 0);
 
   // Then remove 'c' and all other now satisfied (made) clauses.
@@ -388,19 +479,306 @@ void Internal::walk_flip_lit (Walker &walker, int lit) {
 
 /*------------------------------------------------------------------------*/
 
+// Build occurrence lists for the flat copy of clauses in 'walker.lits'.
+// These are shared with the helpers and not modified afterwards.
+
+void Internal::walk_connect_counts (Walker &walker) {
+
+  require_mode (WALK);
+  assert (walker.counting);
+  assert (walker.shared == &walker);
+
+  const size_t num_lits = 2 * (size_t) (max_var + 1);
+
+  auto &occstarts = walker.occstarts;
+  occstarts.assign (num_lits + 1, 0);
+  for (const auto &lit : walker.lits)
+    occstarts[vlit (lit) + 1]++;
+  for (size_t i = 1; i <= num_lits; i++)
+    occstarts[i] += occstarts[i - 1];
+
+  vector<size_t> filled (occstarts.begin (), occstarts.end () - 1);
+  walker.occs.resize (walker.lits.size ());
+  const unsigned num_clauses = walker.starts.size () - 1;
+  for (unsigned c = 0; c < num_clauses; c++) {
+    const size_t end = walker.starts[c + 1];
+    for (size_t i = walker.starts[c]; i != end; i++)
+      walker.occs[filled[vlit (walker.lits[i])]++] = c;
+  }
+
+  walk_count_true (walker);
+}
+
+// Compute true literal counts, break values and the set of unsatisfied
+// clauses of the assignment 'walker.values'.
+
+void Internal::walk_count_true (Walker &walker) {
+
+  require_mode (WALK);
+  assert (walker.counting);
+
+  const Walker &shared = *walker.shared;
+  const unsigned num_clauses = shared.starts.size () - 1;
+  const signed char *values = walker.values;
+
+  walker.counts.resize (num_clauses);
+  walker.critical.resize (num_clauses);
+  walker.position.resize (num_clauses);
+  walker.breaks.assign (max_var + 1, 0);
+  walker.unsat.clear ();
+
+  for (unsigned c = 0; c < num_clauses; c++) {
+    unsigned count = 0;
+    int critical = 0;
+    const size_t end = shared.starts[c + 1];
+    for (size_t i = shared.starts[c]; i != end; i++) {
+      const int lit = shared.lits[i];
+      if (values[lit] > 0)
+        count++, critical ^= lit;
+    }
+    walker.counts[c] = count;
+    walker.critical[c] = critical;
+    if (!count) {
+      walker.position[c] = walker.unsat.size ();
+      walker.unsat.push_back (c);
+    } else if (count == 1)
+      walker.breaks[abs (critical)]++;
+  }
+}
+
+// Same as 'walk_pick_clause' and 'walk_pick_lit' but with break values
+// cached in 'walker.breaks'.  All literals of an unsatisfied clause are
+// false and thus flipping one of them breaks the clauses in which its
+// negation is the only true literal.  As these functions are also used by
+// the helper threads they only update the statistics of 'walker'.
+
+unsigned Internal::walk_pick_unsat (Walker &walker) {
+  require_mode (WALK);
+  assert (!walker.unsat.empty ());
+  int64_t size = walker.unsat.size ();
+  if (size > INT_MAX)
+    size = INT_MAX;
+  int pos = walker.random.pick_int (0, size - 1);
+  return walker.unsat[pos];
+}
+
+int Internal::walk_pick_counted_lit (Walker &walker, unsigned c) {
+  LOG ("picking literal by cached break-count");
+  assert (walker.scores.empty ());
+  const Walker &shared = *walker.shared;
+  const auto begin = shared.lits.begin () + shared.starts[c];
+  const auto end = shared.lits.begin () + shared.starts[c + 1];
+  double sum = 0;
+  int64_t propagations = 0;
+  for (auto i = begin; i != end; i++) {
+    const int lit = *i;
+    assert (walker.values[lit] < 0);
+    if (var (lit).level == 1)
+      continue;
+    propagations++;
+    const unsigned tmp = walker.breaks[abs (lit)];
+    const double score = walker.score (tmp);
+    LOG ("literal %d break-count %u score %g", lit, tmp, score);
+    walker.scores.push_back (score);
+    sum += score;
+  }
+  assert (!walker.scores.empty ());
+  walker.propagations += propagations;
+  const double lim = sum * walker.random.generate_double ();
+  auto i = begin;
+  auto j = walker.scores.begin ();
+  int res;
+  for (;;) {
+    assert (i != end);
+    res = *i++;
+    if (var (res).level > 1)
+      break;
+  }
+  sum = *j++;
+  while (sum <= lim && i != end) {
+    res = *i++;
+    if (var (res).level == 1)
+      continue;
+    sum += *j++;
+  }
+  walker.scores.clear ();
+  LOG ("picking literal %d by cached break-count", res);
+  return res;
+}
+
+void Internal::walk_flip_counted_lit (Walker &walker, int lit) {
+
+  require_mode (WALK);
+  LOG ("flipping assign %d", lit);
+  signed char *values = walker.values;
+  assert (values[lit] < 0);
+
+  const int tmp = sign (lit);
+  const int idx = abs (lit);
+  values[idx] = tmp;
+  values[-idx] = -tmp;
+  walker.flip (idx, max_var);
+
+  auto &counts = walker.counts;
+  auto &critical = walker.critical;
+  auto &breaks = walker.breaks;
+  auto &unsat = walker.unsat;
+  auto &position = walker.position;
+  const auto &occstarts = walker.shared->occstarts;
+  const auto &occs = walker.shared->occs;
+
+  // Clauses with 'lit' gain a true literal.  Those which were unsatisfied
+  // are removed from 'unsat' by moving the last one to their position and
+  // in those which had one true literal that literal is not critical
+  // anymore.
+  //
+  const size_t lit_begin = occstarts[vlit (lit)];
+  const size_t lit_end = occstarts[vlit (lit) + 1];
+  for (size_t i = lit_begin; i != lit_end; i++) {
+    const unsigned c = occs[i];
+    const unsigned count = counts[c]++;
+    if (!count) {
+      const unsigned last = unsat.back ();
+      const unsigned pos = position[c];
+      unsat[pos] = last;
+      position[last] = pos;
+      unsat.pop_back ();
+      breaks[idx]++;
+    } else if (count == 1)
+      breaks[abs (critical[c])]--;
+    critical[c] ^= lit;
+  }
+
+  // Clauses with '-lit' lose a true literal and either become unsatisfied
+  // or their remaining true literal might become critical.
+  //
+  const size_t not_lit_begin = occstarts[vlit (-lit)];
+  const size_t not_lit_end = occstarts[vlit (-lit) + 1];
+  for (size_t i = not_lit_begin; i != not_lit_end; i++) {
+    const unsigned c = occs[i];
+    const unsigned count = --counts[c];
+    critical[c] ^= -lit;
+    if (!count) {
+      position[c] = unsat.size ();
+      unsat.push_back (c);
+      breaks[idx]--;
+    } else if (count == 1)
+      breaks[abs (critical[c])]++;
+  }
+
+  // Every traversed occurrence is an actual memory access and thus counts
+  // like a visited clause during propagation.
+  //
+  const int64_t propagations =
+      1 + (lit_end - lit_begin) + (not_lit_end - not_lit_begin);
+  walker.propagations += propagations;
+}
+
+/*------------------------------------------------------------------------*/
+
 // Check whether to save the current phases as new global minimum.
 
 inline void Internal::walk_save_minimum (Walker &walker) {
-  int64_t broken = walker.broken.size ();
+  int64_t broken = walker.unsatisfied ();
   if (broken >= stats.walk.minimum)
     return;
   VERBOSE (3, "new global minimum %" PRId64 "", broken);
   stats.walk.minimum = broken;
-  for (auto i : vars) {
-    const signed char tmp = vals[i];
-    if (tmp)
+  if (walker.saved) {
+    for (auto i : walker.flipped) {
+      const signed char tmp = vals[i];
+      assert (tmp);
       phases.min[i] = phases.saved[i] = tmp;
+    }
+  } else {
+    for (auto i : vars) {
+      const signed char tmp = vals[i];
+      if (tmp)
+        phases.min[i] = phases.saved[i] = tmp;
+    }
+    walker.saved = true;
   }
+  walker.flipped.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
+// With 'walkjobs' different from one we start helper walkers with their
+// own seed and CB value on a copy of the initial assignment in counting
+// mode.  They only read the flat clauses of the main walker and the levels
+// of variables, which both do not change during flipping.
+
+void Internal::walk_start_helpers (Walker &walker, double size) {
+  assert (walker.counting);
+  assert (walker.helpers.empty ());
+#ifndef NTHREADS
+  size_t jobs = opts.walkjobs ? opts.walkjobs
+                              : std::thread::hardware_concurrency ();
+  if (jobs < 2)
+    return;
+  for (size_t id = 1; id < jobs; id++) {
+    Walker *helper = new Walker (this, size, walker.limit, id);
+    helper->shared = &walker;
+    helper->assigned.assign (vals - max_var, vals + max_var + 1);
+    helper->values = helper->assigned.data () + max_var;
+    walker.helpers.push_back (helper);
+  }
+  PHASE ("walk", stats.walk.count, "starting %zu helper walkers", jobs - 1);
+  for (auto helper : walker.helpers)
+    walker.threads.push_back (
+        std::thread (&Internal::walk_helper, this, std::ref (*helper)));
+#else
+  (void) size;
+#endif
+}
+
+// Each helper flips on its own until it satisfies all clauses, reaches the
+// same propagation limit as the main walker or is asked to stop.
+
+void Internal::walk_helper (Walker &helper) {
+  const Walker &walker = *helper.shared;
+  walk_count_true (helper);
+  helper.save_best ();
+  while (!helper.unsat.empty () && helper.propagations < helper.limit &&
+         !walker.stop.load (std::memory_order_relaxed)) {
+    const unsigned c = walk_pick_unsat (helper);
+    const int lit = walk_pick_counted_lit (helper, c);
+    walk_flip_counted_lit (helper, lit);
+    helper.flips++;
+    if ((int64_t) helper.unsat.size () < helper.minimum)
+      helper.save_best ();
+  }
+}
+
+// Wait for the helpers and save the best assignment found by any of them
+// if it improves the global minimum.  Returns the minimum of the helpers.
+
+int64_t Internal::walk_stop_helpers (Walker &walker) {
+#ifndef NTHREADS
+  for (auto &thread : walker.threads)
+    thread.join ();
+  walker.threads.clear ();
+#endif
+  Walker *best = 0;
+  for (auto helper : walker.helpers) {
+    stats.walk.flips += helper->flips;
+    stats.propagations.walk += helper->propagations;
+    if (!best || helper->minimum < best->minimum)
+      best = helper;
+  }
+  if (!best)
+    return INT64_MAX;
+  const int64_t res = best->minimum;
+  if (res < stats.walk.minimum) {
+    VERBOSE (3, "new global minimum %" PRId64 " of helper", res);
+    stats.walk.minimum = res;
+    for (auto idx : vars) {
+      const signed char tmp = best->best[idx];
+      if (tmp)
+        phases.min[idx] = phases.saved[idx] = tmp;
+    }
+  }
+  return res;
 }
 
 /*------------------------------------------------------------------------*/
@@ -563,7 +941,16 @@ int Internal::walk_round (int64_t limit, bool prev) {
         break;
       }
 
-      if (satisfied) {
+      if (walker.counting) {
+        walker.starts.push_back (walker.lits.size ());
+        walker.lits.insert (walker.lits.end (), lits, lits + size);
+#ifdef LOGGING
+        if (satisfied)
+          watched++;
+        else
+          LOG (c, "broken");
+#endif
+      } else if (satisfied) {
         watch_literal (lits[0], lits[1], c);
 #ifdef LOGGING
         watched++;
@@ -574,9 +961,13 @@ int Internal::walk_round (int64_t limit, bool prev) {
         walker.broken.push_back (c);
       }
     }
+    if (!failed && walker.counting) {
+      walker.starts.push_back (walker.lits.size ());
+      walk_connect_counts (walker);
+    }
 #ifdef LOGGING
     if (!failed) {
-      int64_t broken = walker.broken.size ();
+      int64_t broken = walker.unsatisfied ();
       int64_t total = watched + broken;
       LOG ("watching %" PRId64 " clauses %.0f%% "
            "out of %" PRId64 " (watched and broken)",
@@ -591,7 +982,7 @@ int Internal::walk_round (int64_t limit, bool prev) {
 
   if (!failed) {
 
-    int64_t broken = walker.broken.size ();
+    int64_t broken = walker.unsatisfied ();
 
     PHASE ("walk", stats.walk.count,
            "starting with %" PRId64 " unsatisfied clauses "
@@ -600,22 +991,30 @@ int Internal::walk_round (int64_t limit, bool prev) {
            stats.current.irredundant);
 
     walk_save_minimum (walker);
+    if (walker.counting && broken)
+      walk_start_helpers (walker, average_size);
 
     int64_t minimum = broken;
 #ifndef QUIET
     int64_t flips = 0;
 #endif
-    while (!terminated_asynchronously () && !walker.broken.empty () &&
+    while (!terminated_asynchronously () && broken &&
            walker.propagations < walker.limit) {
 #ifndef QUIET
       flips++;
 #endif
       stats.walk.flips++;
       stats.walk.broken += broken;
-      Clause *c = walk_pick_clause (walker);
-      const int lit = walk_pick_lit (walker, c);
-      walk_flip_lit (walker, lit);
-      broken = walker.broken.size ();
+      if (walker.counting) {
+        const unsigned c = walk_pick_unsat (walker);
+        const int lit = walk_pick_counted_lit (walker, c);
+        walk_flip_counted_lit (walker, lit);
+      } else {
+        Clause *c = walk_pick_clause (walker);
+        const int lit = walk_pick_lit (walker, c);
+        walk_flip_lit (walker, lit);
+      }
+      broken = walker.unsatisfied ();
       LOG ("now have %" PRId64 " broken clauses in total", broken);
       if (broken >= minimum)
         continue;
@@ -625,6 +1024,21 @@ int Internal::walk_round (int64_t limit, bool prev) {
       walk_save_minimum (walker);
     }
 
+    if (walker.counting)
+      stats.propagations.walk += walker.propagations;
+
+    if (!walker.helpers.empty ()) {
+      if (!minimum || terminated_asynchronously ())
+        walker.stop = true;
+      const int64_t flips_before = stats.walk.flips;
+      const int64_t helped = walk_stop_helpers (walker);
+      PHASE ("walk", stats.walk.count,
+             "best helper minimum %" PRId64 " in %" PRId64 " helper flips",
+             helped, stats.walk.flips - flips_before);
+      if (helped < minimum)
+        minimum = helped;
+    }
+
     if (minimum < old_global_minimum)
       PHASE ("walk", stats.walk.count,
              "%snew global minimum %" PRId64 "%s in %" PRId64 " flips and "
@@ -0,0 +1,140 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+
+// Connects a 'Learner' and a 'BatchLearner' to the same solver, which
+// both have to receive the same sequence of learned clauses, with and
+// without buffering ('learnbatch').  Buffering only delays delivery,
+// thus the same formula has to yield the same clauses for every setting.
+
+class Single : CaDiCaL::Learner {
+  CaDiCaL::Solver *solver;
+  std::vector<int> clause;
+
+public:
+  Clauses clauses;
+  Single (CaDiCaL::Solver *s) : solver (s) {
+    solver->connect_learner (this);
+  }
+  ~Single () { solver->disconnect_learner (); }
+  bool learning (int size) { return size < 8; }
+  void learn (int lit) {
+    if (lit)
+      clause.push_back (lit);
+    else
+      clauses.push_back (clause), clause.clear ();
+  }
+};
+
+class Batch : CaDiCaL::BatchLearner {
+  CaDiCaL::Solver *solver;
+
+public:
+  Clauses clauses;
+  size_t flushes, flushed; // number of flushes and clauses before last
+  Batch (CaDiCaL::Solver *s) : solver (s), flushes (0), flushed (0) {
+    solver->connect_batch_learner (this);
+  }
+  void disconnect () { solver->disconnect_batch_learner (); }
+  bool learning (int size, int glue) {
+    assert (glue <= size);
+    return size < 8;
+  }
+  void learn (const int *lits, size_t size, int glue, bool unit) {
+    assert (unit == (size == 1));
+    if (size < 2)
+      assert (!glue);
+    else
+      assert (glue > 0);
+    clauses.push_back (std::vector<int> (lits, lits + size));
+  }
+  void flush () {
+    assert (flushed < clauses.size ());
+    flushes++;
+    flushed = clauses.size ();
+  }
+};
+
+static const Pigeons pigeons (6);
+
+static Clauses run (int learnbatch) {
+  CaDiCaL::Solver solver;
+  solver.set ("learnbatch", learnbatch);
+  Single single (&solver);
+  Batch batch (&solver);
+  add (solver, pigeons.clauses (0, 7));
+  int res = solver.solve ();
+  std::cout << "learnbatch " << learnbatch << " returns " << res
+            << " after " << single.clauses.size () << " single and "
+            << batch.clauses.size () << " batched clauses in "
+            << batch.flushes << " flushes" << std::endl;
+  assert (res == 20);
+  assert (single.clauses.size () > 10);
+  assert (single.clauses == batch.clauses);
+  assert (single.clauses.back ().empty ());
+  if (learnbatch)
+    assert (batch.flushed == batch.clauses.size ());
+  if (!learnbatch)
+    assert (!batch.flushes);
+  else if (learnbatch < 100)
+    assert (batch.flushes > 1);
+  else
+    assert (batch.flushes == 1); // only at the end of 'solve'
+
+  // Nothing is left buffered after 'solve', thus disconnecting (which
+  // flushes remaining clauses) neither delivers clauses nor flushes.
+  //
+  const size_t clauses = batch.clauses.size (), flushes = batch.flushes;
+  batch.disconnect ();
+  assert (batch.clauses.size () == clauses);
+  assert (batch.flushes == flushes);
+
+  return batch.clauses;
+}
+
+// Incremental solving with a batch learner replaced between calls, which
+// gets only the clauses learned after connecting it.  The second call gets
+// another pigeon, which makes the formula unsatisfiable.
+
+static Clauses replace (int learnbatch) {
+  CaDiCaL::Solver solver;
+  solver.set ("learnbatch", learnbatch);
+  Single single (&solver);
+  Batch first (&solver);
+  add (solver, pigeons.clauses (0, 6));
+  solver.assume (-1);
+  int res = solver.solve ();
+  assert (res == 10);
+  const Clauses before = single.clauses;
+  assert (before == first.clauses);
+  Batch second (&solver);
+  assert (first.clauses == before);
+  add (solver, pigeons.clauses (6, 7));
+  res = solver.solve ();
+  assert (res == 20);
+  assert (first.clauses == before);
+  Clauses after (single.clauses.begin () + before.size (),
+                 single.clauses.end ());
+  assert (after == second.clauses);
+  if (learnbatch)
+    assert (second.flushed == second.clauses.size ());
+  second.disconnect ();
+  std::cout << "learnbatch " << learnbatch << " replaced learner after "
+            << before.size () << " and " << after.size () << " clauses"
+            << std::endl;
+  return single.clauses;
+}
+
+int main () {
+  const Clauses unbatched = run (0);
+  assert (run (1) == unbatched);
+  assert (run (10) == unbatched);
+  assert (run (1000000) == unbatched);
+  assert (replace (0) == replace (10));
+  return 0;
+}
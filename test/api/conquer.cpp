@@ -0,0 +1,75 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+
+// Cube-and-conquer on an unsatisfiable pigeon hole problem and then on the
+// satisfiable variant with as many pigeons as holes.  Cubes generated by a
+// separate solver on the same formula are the same as those conquered,
+// thus the model found for a satisfiable cube has to extend one of them.
+// Without cubes (depth zero) the portfolio falls back to plain solving,
+// which always has a winning worker.
+
+static const int n = 6;
+
+static Clauses cubes (const Pigeons &pigeons, int p, int depth) {
+  CaDiCaL::Solver solver;
+  add (solver, pigeons.clauses (0, p));
+  return solver.generate_cubes (depth).cubes;
+}
+
+static bool extends (CaDiCaL::Solver *solver, const Clause &cube) {
+  for (const auto &lit : cube)
+    if (solver->val (lit) < 0)
+      return false;
+  return true;
+}
+
+int main () {
+
+  const Pigeons pigeons (n);
+
+  {
+    const Clauses generated = cubes (pigeons, n + 1, 4);
+    std::cout << "refuting " << generated.size () << " cubes" << std::endl;
+    assert (generated.size () > 1);
+    CaDiCaL::Solver solver;
+    add (solver, pigeons.clauses (0, n + 1));
+    CaDiCaL::PortfolioSolver portfolio (&solver, 4);
+    int res = portfolio.cube_and_conquer (4);
+    assert (res == 20);
+  }
+
+  {
+    const Clauses generated = cubes (pigeons, n, 4);
+    std::cout << "solving " << generated.size () << " cubes" << std::endl;
+    assert (generated.size () > 1);
+    CaDiCaL::Solver solver;
+    add (solver, pigeons.clauses (0, n));
+    CaDiCaL::PortfolioSolver portfolio (&solver, 4);
+    int res = portfolio.cube_and_conquer (4);
+    assert (res == 10);
+    CaDiCaL::Solver *winner = portfolio.winner ();
+    assert (winner);
+    assert (pigeons.separated (portfolio, n));
+    size_t extended = 0;
+    for (const auto &cube : generated)
+      extended += extends (winner, cube);
+    assert (extended > 0);
+  }
+
+  {
+    CaDiCaL::Solver solver;
+    add (solver, pigeons.clauses (0, n + 1));
+    CaDiCaL::PortfolioSolver portfolio (&solver, 4);
+    int res = portfolio.cube_and_conquer (0);
+    assert (res == 20);
+    assert (portfolio.winner ());
+  }
+
+  return 0;
+}
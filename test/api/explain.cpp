@@ -0,0 +1,147 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <map>
+
+// Pigeon hole formulas where the solver only gets the clauses which put
+// every pigeon into some hole, while the external propagator enforces that
+// at most one pigeon sits in each hole.  This propagator propagates on all
+// decision levels and thus exercises explaining external propagations
+// with and without 'explainbound'.  Only the bounded explanation leaves
+// propagations below the conflict level unexplained.
+
+class Holes : public CaDiCaL::ExternalPropagator {
+  CaDiCaL::Solver *solver;
+  const Pigeons &pigeons;
+  const int count; // of pigeons
+  std::vector<signed char> fixed, vals;
+  std::vector<int> trail;
+  std::vector<size_t> control;
+  std::map<int, int> reasons; // propagated literal to other literal
+  std::vector<int> reason;
+  size_t pos;
+
+  signed char val (int lit) const {
+    const int idx = abs (lit);
+    signed char res = fixed[idx] ? fixed[idx] : vals[idx];
+    return lit < 0 ? -res : res;
+  }
+
+public:
+  int propagated, explained;
+
+  Holes (CaDiCaL::Solver *s, const Pigeons &ps, int c)
+      : solver (s), pigeons (ps), count (c), fixed (ps.vars (c) + 1, 0),
+        vals (ps.vars (c) + 1, 0), pos (0), propagated (0), explained (0) {
+    solver->connect_external_propagator (this);
+    for (int i = 1; i <= pigeons.vars (count); i++)
+      solver->add_observed_var (i);
+  }
+  ~Holes () { solver->disconnect_external_propagator (); }
+
+  void notify_assignment (int lit, bool is_fixed) {
+    const int idx = abs (lit);
+    const signed char tmp = lit < 0 ? -1 : 1;
+    if (is_fixed)
+      fixed[idx] = tmp;
+    else
+      vals[idx] = tmp, trail.push_back (idx);
+  }
+  void notify_new_decision_level () { control.push_back (trail.size ()); }
+  void notify_backtrack (size_t new_level) {
+    assert (new_level <= control.size ());
+    const size_t size = control[new_level];
+    while (trail.size () > size)
+      vals[trail.back ()] = 0, trail.pop_back ();
+    control.resize (new_level);
+  }
+
+  bool cb_check_found_model (const std::vector<int> &model) {
+    const int holes = pigeons.holes;
+    for (int h = 0; h < holes; h++) {
+      int placed = 0;
+      for (const auto &lit : model)
+        if (lit > 0 && (lit - 1) % holes == h)
+          placed++;
+      if (placed > 1)
+        return false;
+    }
+    return true;
+  }
+
+  // Propagates (or falsifies) the other pigeons in the hole of a pigeon.
+
+  int cb_propagate () {
+    for (int h = 0; h < pigeons.holes; h++)
+      for (int p = 0; p < count; p++) {
+        const int lit = pigeons.var (p, h);
+        if (val (lit) <= 0)
+          continue;
+        for (int q = 0; q < count; q++) {
+          const int other = pigeons.var (q, h);
+          if (q == p || val (other) < 0)
+            continue;
+          reasons[-other] = -lit;
+          propagated++;
+          return -other;
+        }
+      }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit (int propagated_lit) {
+    if (reason.empty ()) {
+      assert (reasons.count (propagated_lit));
+      reason = {propagated_lit, reasons[propagated_lit], 0};
+      pos = 0;
+      explained++;
+    }
+    const int res = reason[pos++];
+    if (!res)
+      reason.clear ();
+    return res;
+  }
+
+  bool cb_has_external_clause () { return false; }
+  int cb_add_external_clause_lit () { return 0; }
+};
+
+// Returns the number of propagations left unexplained.
+
+static int64_t solve (int count, int holes, bool explainbound,
+                      int expected) {
+  CaDiCaL::Solver solver;
+  solver.set ("check", 1);
+  solver.set ("explainbound", explainbound);
+  const Pigeons pigeons (holes);
+  int64_t unexplained;
+  {
+    Holes propagator (&solver, pigeons, count);
+    for (int p = 0; p < count; p++)
+      add (solver, pigeons.pigeon (p));
+    const int res = solver.solve ();
+    unexplained = solver.get_statistic_value ("unexplained");
+    std::cout << count << " pigeons " << holes << " holes explainbound "
+              << explainbound << " returns " << res << " after "
+              << propagator.propagated << " propagations with "
+              << propagator.explained << " explained and " << unexplained
+              << " unexplained" << std::endl;
+    assert (res == expected);
+    if (res == 10)
+      assert (pigeons.separated (solver, count));
+  }
+  return unexplained;
+}
+
+int main () {
+  assert (!solve (7, 6, false, 20));
+  assert (!solve (6, 6, false, 10));
+  assert (solve (7, 6, true, 20) > 0);
+  solve (6, 6, true, 10);
+  return 0;
+}
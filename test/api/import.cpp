@@ -0,0 +1,195 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+// Imports clauses learned by one solver into another solver on the same
+// formula with 'import_redundant_clause', partially before solving and
+// partially during solving (from the terminator call-back).  The receiving
+// solver checks its proof internally and has to count imported clauses in
+// its statistics.  Importing all clauses before solving has to shorten the
+// search compared to the exporting solver.  With a textual FRAT proof trace
+// we further check that imported clauses are traced as (trusted) original
+// clauses.
+
+static Clauses formula () { return Pigeons (6).clauses (0, 7); }
+
+struct Export : CaDiCaL::BatchLearner {
+  Clauses clauses;
+  std::vector<int> glues;
+  bool learning (int size, int glue) {
+    (void) glue;
+    return 0 < size && size < 6;
+  }
+  void learn (const int *lits, size_t size, int glue, bool unit) {
+    (void) unit;
+    clauses.push_back (Clause (lits, lits + size));
+    glues.push_back (glue);
+  }
+};
+
+struct Import : CaDiCaL::Terminator {
+  CaDiCaL::Solver *solver;
+  const Export &exported;
+  size_t next;
+  Import (CaDiCaL::Solver *s, const Export &e)
+      : solver (s), exported (e), next (0) {
+    solver->connect_terminator (this);
+  }
+  ~Import () { solver->disconnect_terminator (); }
+  void import (size_t count) {
+    while (count-- && next < exported.clauses.size ()) {
+      const Clause &clause = exported.clauses[next];
+      solver->import_redundant_clause (clause.data (), clause.size (),
+                                       exported.glues[next]);
+      next++;
+    }
+  }
+  bool terminate () {
+    import (3);
+    return false;
+  }
+};
+
+static std::string path (const char *name) {
+  const char *prefix = getenv ("CADICALBUILD");
+  std::string res = prefix ? prefix : ".";
+  res += "/test-api-import-";
+  res += name;
+  res += ".frat";
+  return res;
+}
+
+static Clause sorted (Clause clause) {
+  std::sort (clause.begin (), clause.end ());
+  return clause;
+}
+
+// Returns the clauses of all original steps in a textual FRAT proof.
+
+static std::set<Clause> originals (const std::string &name) {
+  std::set<Clause> res;
+  std::ifstream file (name);
+  std::string line;
+  while (std::getline (file, line)) {
+    if (line.empty () || line[0] != 'o')
+      continue;
+    std::istringstream stream (line.substr (1));
+    int64_t id;
+    stream >> id;
+    Clause clause;
+    int lit;
+    while (stream >> lit && lit)
+      clause.push_back (lit);
+    res.insert (sorted (clause));
+  }
+  return res;
+}
+
+static void run (const Export &exported, const char *name) {
+  const Clauses clauses = formula ();
+  const bool frat = name && std::string (name) == "frat";
+  const std::string proof = path (name ? name : "none");
+  int res;
+  {
+    CaDiCaL::Solver solver;
+    if (name) {
+      solver.set ("check", 1);
+      if (std::string (name) != "drat")
+        solver.set ("lrat", 1);
+      if (frat) {
+        solver.set ("lratfrat", 1);
+        solver.set ("binary", 0);
+        solver.trace_proof (proof.c_str ());
+      }
+    }
+    add (solver, clauses);
+    Import importer (&solver, exported);
+    importer.import (20);
+    const int unknown[2] = {1, 1000}; // dropped (unknown variable)
+    solver.import_redundant_clause (unknown, 2, 2);
+    res = solver.solve ();
+    const int64_t imported = solver.get_statistic_value ("imported");
+    std::cout << "importing " << (name ? name : "without proof")
+              << " returns " << res << " after importing "
+              << importer.next << " of " << exported.clauses.size ()
+              << " clauses (" << imported << " imported)" << std::endl;
+    assert (importer.next > 20);
+    assert (imported > 0);
+    assert (imported <= (int64_t) importer.next);
+  }
+  assert (res == 20);
+  if (!frat)
+    return;
+
+  // All original steps are either input or imported clauses and at least
+  // some imported clauses have to show up as original steps.
+  //
+  std::set<Clause> input, imported;
+  for (const auto &clause : clauses)
+    input.insert (sorted (clause));
+  for (const auto &clause : exported.clauses)
+    imported.insert (sorted (clause));
+  size_t traced = 0;
+  for (const auto &clause : originals (proof)) {
+    assert (clause.size () < 1000);
+    for (const auto &lit : clause)
+      assert (abs (lit) != 1000);
+    if (input.count (clause))
+      continue;
+    assert (imported.count (clause));
+    traced++;
+  }
+  std::cout << "traced " << traced << " imported clauses as original"
+            << std::endl;
+  assert (traced > 0);
+}
+
+static void shortens (const Export &exported, int64_t conflicts) {
+  CaDiCaL::Solver solver;
+  add (solver, formula ());
+  Import importer (&solver, exported);
+  importer.import (exported.clauses.size ());
+  const int res = solver.solve ();
+  const int64_t imported = solver.get_statistic_value ("imported");
+  const int64_t needed = solver.get_statistic_value ("conflicts");
+  std::cout << "importing all clauses returns " << res << " after "
+            << needed << " conflicts with " << imported << " imported"
+            << std::endl;
+  assert (res == 20);
+  assert (imported > 0);
+  assert (needed < conflicts);
+}
+
+int main () {
+  Export exported;
+  int64_t conflicts;
+  {
+    CaDiCaL::Solver solver;
+    solver.connect_batch_learner (&exported);
+    add (solver, formula ());
+    const int res = solver.solve ();
+    assert (res == 20);
+    solver.disconnect_batch_learner ();
+    conflicts = solver.get_statistic_value ("conflicts");
+  }
+  std::cout << "exported " << exported.clauses.size () << " clauses in "
+            << conflicts << " conflicts" << std::endl;
+  assert (exported.clauses.size () > 10);
+  shortens (exported, conflicts);
+  run (exported, 0);
+  run (exported, "drat");
+  run (exported, "lrat");
+  run (exported, "frat");
+  return 0;
+}
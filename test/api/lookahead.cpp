@@ -0,0 +1,71 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+
+// Lookahead and cube generation with probes scored sequentially on the
+// solver ('lookaheadpar=0') and on a clause snapshot by one or several
+// threads ('lookaheadjobs').  All variants have to pick the same lookahead
+// literal and generate the same cubes.  The CNF tests only run both
+// variants through '--conquer'.
+
+struct Result {
+  int lit;
+  Clauses cubes;
+};
+
+static Result run (const Clauses &clauses, int par, int jobs, int depth) {
+  Result res;
+  {
+    CaDiCaL::Solver solver;
+    solver.set ("lookaheadpar", par);
+    solver.set ("lookaheadjobs", jobs);
+    add (solver, clauses);
+    res.lit = solver.lookahead ();
+  }
+  {
+    CaDiCaL::Solver solver;
+    solver.set ("lookaheadpar", par);
+    solver.set ("lookaheadjobs", jobs);
+    add (solver, clauses);
+    res.cubes = solver.generate_cubes (depth).cubes;
+  }
+  return res;
+}
+
+static void check (const char *name, const Clauses &clauses, int depth) {
+  const Result sequential = run (clauses, 0, 1, depth);
+  std::cout << name << " lookahead " << sequential.lit << " and "
+            << sequential.cubes.size () << " cubes of depth " << depth
+            << std::endl;
+  assert (sequential.lit);
+  assert (sequential.cubes.size () > 1);
+  const int jobs[] = {1, 2, 4};
+  for (const auto &j : jobs) {
+    const Result parallel = run (clauses, 1, j, depth);
+    assert (parallel.lit == sequential.lit);
+    assert (parallel.cubes == sequential.cubes);
+  }
+}
+
+int main () {
+  const Pigeons pigeons (6);
+  check ("pigeons 6", pigeons.clauses (0, 6), 4);
+  check ("pigeons 7", pigeons.clauses (0, 7), 5);
+
+  // Chain of equivalences with a few ternary clauses, where probes imply
+  // a different number of literals.
+
+  Clauses chain;
+  const int n = 40;
+  for (int i = 1; i < n; i++)
+    chain.push_back ({-i, i + 1}), chain.push_back ({i, -(i + 1)});
+  for (int i = 1; i + 2 <= n; i += 3)
+    chain.push_back ({i, n + i, -(n + i + 1)});
+  check ("chain", chain, 3);
+  return 0;
+}
@@ -0,0 +1,84 @@
+#ifndef _pigeons_hpp_INCLUDED
+#define _pigeons_hpp_INCLUDED
+
+#include "../../src/cadical.hpp"
+
+#include <vector>
+
+// Pigeon hole formulas shared by several API tests.  The variable 'var (p,
+// h)' means that pigeon 'p' sits in hole 'h'.  Pigeons can be added one
+// after the other, since the numbering of variables only depends on the
+// number of holes.  Variables starting at 'vars (pigeons)' are free for
+// other purposes (like selectors).
+
+typedef std::vector<int> Clause;
+typedef std::vector<Clause> Clauses;
+
+struct Pigeons {
+
+  const int holes;
+
+  Pigeons (int h) : holes (h) {}
+
+  int var (int pigeon, int hole) const { return pigeon * holes + hole + 1; }
+  int vars (int pigeons) const { return pigeons * holes; }
+
+  // Clause putting the pigeon into some hole.
+
+  Clause pigeon (int p) const {
+    Clause res;
+    for (int h = 0; h < holes; h++)
+      res.push_back (var (p, h));
+    return res;
+  }
+
+  // Binary clauses which prevent that the pigeon shares a hole with any of
+  // the pigeons before it.
+
+  Clauses exclusions (int p) const {
+    Clauses res;
+    for (int h = 0; h < holes; h++)
+      for (int q = 0; q < p; q++)
+        res.push_back ({-var (q, h), -var (p, h)});
+    return res;
+  }
+
+  // All clauses of the pigeons 'from' up to 'to' (excluded).
+
+  Clauses clauses (int from, int to) const {
+    Clauses res;
+    for (int p = from; p < to; p++) {
+      res.push_back (pigeon (p));
+      for (const auto &clause : exclusions (p))
+        res.push_back (clause);
+    }
+    return res;
+  }
+
+  // Check that no two pigeons of a model share a hole.
+
+  template <class Solver>
+  bool separated (Solver &solver, int pigeons) const {
+    for (int h = 0; h < holes; h++) {
+      int count = 0;
+      for (int p = 0; p < pigeons; p++)
+        count += solver.val (var (p, h)) > 0;
+      if (count > 1)
+        return false;
+    }
+    return true;
+  }
+};
+
+static inline void add (CaDiCaL::Solver &solver, const Clause &clause) {
+  for (const auto &lit : clause)
+    solver.add (lit);
+  solver.add (0);
+}
+
+static inline void add (CaDiCaL::Solver &solver, const Clauses &clauses) {
+  for (const auto &clause : clauses)
+    add (solver, clause);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "pigeons.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+
+// Incremental pigeon hole problem solved with a portfolio.  Each pigeon is
+// guarded by a frozen selector variable, which is assumed to require the
+// pigeon to be placed.  Pigeons are added one after the other, until there
+// are more pigeons than holes and the selectors form the failed core.
+//
+// With more than one worker the workers share learned clauses, thus the
+// primary solver has to export and import clauses.  Sharing limits are
+// relaxed, since these formulas only need a few hundred conflicts.  A
+// portfolio with one worker solves on the primary solver only and does not
+// share anything.
+
+static const int n = 6;
+
+static int selector (const Pigeons &pigeons, int p) {
+  return pigeons.vars (n + 1) + 1 + p;
+}
+
+static void run (int threads) {
+
+  CaDiCaL::Solver solver;
+  solver.set ("shareglue", 8);
+  solver.set ("shareint", 1);
+  CaDiCaL::PortfolioSolver portfolio (&solver, threads);
+  const Pigeons pigeons (n);
+
+  for (int p = 0; p < n + 1; p++) {
+
+    add (solver, pigeons.exclusions (p));
+    Clause clause = pigeons.pigeon (p);
+    clause.push_back (-selector (pigeons, p));
+    add (solver, clause);
+
+    solver.freeze (selector (pigeons, p));
+    for (int q = 0; q <= p; q++)
+      solver.assume (selector (pigeons, q));
+
+    int res = portfolio.solve ();
+    assert (portfolio.winner ());
+
+    if (p < n) {
+      assert (res == 10);
+      for (int q = 0; q <= p; q++)
+        assert (portfolio.val (selector (pigeons, q)) > 0);
+      assert (pigeons.separated (portfolio, p + 1));
+    } else {
+      assert (res == 20);
+      for (int q = 0; q <= p; q++)
+        assert (portfolio.failed (selector (pigeons, q)));
+    }
+  }
+
+  // Without assumptions the formula is satisfiable by dropping a pigeon.
+
+  int res = portfolio.solve ();
+  assert (res == 10);
+
+  const int64_t exported = solver.get_statistic_value ("exported");
+  const int64_t imported = solver.get_statistic_value ("imported");
+  std::cout << threads << " workers: primary solver exported " << exported
+            << " and imported " << imported << " clauses" << std::endl;
+  if (threads == 1)
+    assert (!exported && !imported);
+#ifndef NTHREADS
+  else
+    assert (exported > 0 && imported > 0);
+#endif
+}
+
+int main () {
+  run (1);
+  run (4);
+  return 0;
+}
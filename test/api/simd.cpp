@@ -0,0 +1,165 @@
+#include "../../src/simd.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Checks the AVX2 kernel for skipping false literals against the scalar
+// loop of the replacement watch search for clause lengths from 8 to 200
+// literals.  As in 'Internal::enlarge_vals' the table of values has only
+// three bytes of padding in front of the most negative literal, which are
+// the only bytes outside of the table the gather is allowed to touch.
+//
+// Called with 'bench' as argument the same kernel is instead timed against
+// the scalar loop per clause length bucket and fraction of false literals
+// (in nanoseconds per clause, best of seven rounds), which is how the
+// numbers in the commit message adding the kernel were obtained:
+//
+//   ./configure && make test && build/test-api-simd bench
+
+struct Values {
+  std::vector<signed char> table;
+  signed char *vals;
+  const int vars;
+  Values (int n) : table (2 * (size_t) n + 1 + 3), vars (n) {
+    vals = table.data () + 3 + n;
+  }
+  signed char &operator[] (int lit) { return vals[lit]; }
+};
+
+static uint64_t state = 1;
+
+static unsigned pick (unsigned range) {
+  state = state * 6364136223846793005ul + 1442695040888963407ul;
+  return (state >> 32) % range;
+}
+
+// Assigns all variables and generates clauses in which each literal is
+// false with probability 'per_mille / 1000'.  The extreme variables are
+// included, since the gathers for them touch the padding and the last
+// byte of the table.
+
+static void generate (Values &vals, std::vector<int> &lits, int size,
+                      int count, unsigned per_mille) {
+  for (int idx = 1; idx <= vals.vars; idx++) {
+    const signed char tmp = pick (2) ? 1 : -1;
+    vals[idx] = tmp, vals[-idx] = -tmp;
+  }
+  lits.clear ();
+  for (int i = 0; i < count; i++)
+    for (int j = 0; j < size; j++) {
+      int idx = pick (vals.vars) + 1;
+      if (j < 2)
+        idx = j ? vals.vars : 1;
+      int lit = vals[idx] < 0 ? idx : -idx;
+      if (pick (1000) >= per_mille)
+        lit = -lit;
+      lits.push_back (lit);
+    }
+}
+
+static int *scalar (Values &vals, int *k, const int *end) {
+  while (k != end && vals[*k] < 0)
+    k++;
+  return k;
+}
+
+#ifdef HAVE_AVX2
+
+static int *kernel (Values &vals, int *k, const int *end) {
+  k = CaDiCaL::avx2_skip_false_literals (vals.vals, k, end);
+  return scalar (vals, k, end);
+}
+
+static void check (Values &vals, std::vector<int> &lits, int size) {
+  for (int *c = lits.data (); c != lits.data () + lits.size (); c += size) {
+    const int *end = c + size;
+    int *k = CaDiCaL::avx2_skip_false_literals (vals.vals, c, end);
+    assert (c <= k && k <= end);
+    for (int *p = c; p != k; p++)
+      assert (vals[*p] < 0);
+    if (end - k >= 8)
+      assert (vals[*k] >= 0);
+    assert (kernel (vals, c, end) == scalar (vals, c, end));
+  }
+}
+
+typedef int *(*Scan) (Values &, int *, const int *);
+
+static double measure (Scan scan, Values &vals, std::vector<int> &lits,
+                       int size) {
+  double best = 0;
+  uintptr_t sum = 0;
+  for (int round = 0; round < 7; round++) {
+    const auto start = std::chrono::steady_clock::now ();
+    int *c = lits.data (), *end = c + lits.size ();
+    for (; c != end; c += size)
+      sum += scan (vals, c, c + size) - c;
+    const auto stop = std::chrono::steady_clock::now ();
+    const double ns =
+        std::chrono::duration<double, std::nano> (stop - start).count ();
+    if (!round || ns < best)
+      best = ns;
+  }
+  assert (sum);
+  return best / (lits.size () / size);
+}
+
+static const int sizes[] = {8, 9, 15, 16, 32, 64, 128, 200};
+static const unsigned falsities[] = {500, 950, 999, 1000};
+
+static void test () {
+  std::vector<int> lits;
+  Values vals (1000);
+  for (const auto &size : sizes)
+    for (const auto &per_mille : falsities) {
+      generate (vals, lits, size, 1000, per_mille);
+      check (vals, lits, size);
+    }
+  printf ("checked AVX2 kernel on %zu clause lengths\n",
+          sizeof sizes / sizeof *sizes);
+}
+
+static void benchmark () {
+  std::vector<int> lits;
+  const int vars[] = {1 << 16, 1 << 20};
+  for (const auto &n : vars) {
+    Values vals (n);
+    printf ("%d variables:\n", n);
+    printf ("%8s %8s %12s %12s %8s\n", "length", "false", "scalar",
+            "avx2", "speedup");
+    for (const auto &size : sizes)
+      for (const auto &per_mille : falsities) {
+        generate (vals, lits, size, (1 << 22) / size, per_mille);
+        const double s = measure (scalar, vals, lits, size);
+        const double v = measure (kernel, vals, lits, size);
+        printf ("%8d %7.1f%% %10.2fns %10.2fns %7.2fx\n", size,
+                per_mille / 10.0, s, v, s / v);
+      }
+  }
+}
+
+#endif
+
+int main (int argc, char **argv) {
+#ifdef HAVE_AVX2
+  if (CaDiCaL::avx2_supported ()) {
+    if (argc > 1 && !strcmp (argv[1], "bench"))
+      benchmark ();
+    else
+      test ();
+    return 0;
+  }
+#else
+  (void) argc, (void) argv;
+#endif
+  printf ("AVX2 kernel not available\n");
+  return 0;
+}
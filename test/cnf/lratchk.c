@@ -0,0 +1,336 @@
+/*
+ * Simple LRAT proof checker for testing trimmed proofs.  It reads a DIMACS
+ * formula and an LRAT proof in textual or binary format.  Every added
+ * clause has to be implied by reverse unit propagation over the clauses in
+ * its hints in the given order, deleted clauses have to exist and the
+ * empty clause has to be derived.  Hints of RAT steps are not supported.
+ */
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void die (const char *msg, ...) {
+  va_list ap;
+  fputs ("*** lratchk: ", stdout);
+  va_start (ap, msg);
+  vfprintf (stdout, msg, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+  exit (1);
+}
+
+static void msg (const char *msg, ...) {
+  va_list ap;
+  fputs ("c [lratchk] ", stdout);
+  va_start (ap, msg);
+  vprintf (msg, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+}
+
+typedef struct Stack {
+  int64_t *start, *top, *end;
+} Stack;
+
+static void push (Stack *s, int64_t x) {
+  if (s->top == s->end) {
+    size_t size = s->end - s->start, count = s->top - s->start;
+    size = size ? 2 * size : 16;
+    s->start = realloc (s->start, size * sizeof *s->start);
+    if (!s->start)
+      die ("out of memory");
+    s->top = s->start + count;
+    s->end = s->start + size;
+  }
+  *s->top++ = x;
+}
+
+static int **clauses;   /* indexed by clause identifier */
+static int64_t size_clauses;
+
+static signed char *vals; /* indexed by variable */
+static int64_t size_vals;
+
+static Stack lits, hints, trail;
+
+static FILE *file;
+static int binary;
+static int64_t lineno = 1, added, deleted;
+
+static void enlarge_clauses (int64_t id) {
+  int64_t size = size_clauses ? size_clauses : 1024;
+  while (size <= id)
+    size *= 2;
+  clauses = realloc (clauses, size * sizeof *clauses);
+  if (!clauses)
+    die ("out of memory");
+  memset (clauses + size_clauses, 0,
+          (size - size_clauses) * sizeof *clauses);
+  size_clauses = size;
+}
+
+static void enlarge_vals (int64_t idx) {
+  int64_t size = size_vals ? size_vals : 1024;
+  while (size <= idx)
+    size *= 2;
+  vals = realloc (vals, size);
+  if (!vals)
+    die ("out of memory");
+  memset (vals + size_vals, 0, size - size_vals);
+  size_vals = size;
+}
+
+static void reserve_vals (void) {
+  int64_t *p;
+  for (p = lits.start; p != lits.top; p++) {
+    int64_t idx = *p < 0 ? -*p : *p;
+    if (idx > INT32_MAX)
+      die ("literal %" PRId64 " too large", *p);
+    if (idx >= size_vals)
+      enlarge_vals (idx);
+  }
+}
+
+static void add_clause (int64_t id) {
+  int64_t size = lits.top - lits.start, i;
+  int *c;
+  if (id <= 0)
+    die ("invalid clause identifier %" PRId64, id);
+  if (id >= size_clauses)
+    enlarge_clauses (id);
+  if (clauses[id])
+    die ("clause %" PRId64 " already exists", id);
+  reserve_vals ();
+  c = malloc ((size + 1) * sizeof *c);
+  if (!c)
+    die ("out of memory");
+  for (i = 0; i < size; i++)
+    c[i] = (int) lits.start[i];
+  c[size] = 0;
+  clauses[id] = c;
+}
+
+static int val (int lit) {
+  int res = vals[abs (lit)];
+  return lit < 0 ? -res : res;
+}
+
+static void assign (int lit) {
+  vals[abs (lit)] = lit < 0 ? -1 : 1;
+  push (&trail, lit);
+}
+
+static void backtrack (void) {
+  while (trail.top != trail.start) {
+    int lit = (int) *--trail.top;
+    vals[abs (lit)] = 0;
+  }
+}
+
+/* Assign the negation of the added clause and propagate the hints, where
+ * each hint has to become unit or falsified, until a falsified one is
+ * found.  Returns zero on success.
+ */
+static const char *check (void) {
+  int64_t *p;
+  reserve_vals ();
+  for (p = lits.start; p != lits.top; p++) {
+    int lit = (int) *p, tmp = val (lit);
+    if (tmp > 0)
+      return 0; /* tautological or duplicated negated literal */
+    if (!tmp)
+      assign (-lit);
+  }
+  for (p = hints.start; p != hints.top; p++) {
+    int64_t hint = *p;
+    int *c, *q, unit = 0;
+    if (hint < 0)
+      return "RAT hints not supported";
+    if (hint >= size_clauses || !(c = clauses[hint]))
+      return "hint refers to non-existing clause";
+    for (q = c; *q; q++) {
+      int tmp = val (*q);
+      if (tmp > 0)
+        return "hint clause satisfied";
+      if (tmp < 0)
+        continue;
+      if (unit && unit != *q)
+        return "hint clause not unit";
+      unit = *q;
+    }
+    if (!unit)
+      return 0;
+    assign (unit);
+  }
+  return "hints do not yield a conflict";
+}
+
+/* Binary numbers are variable-length encoded in 7-bit chunks. */
+
+static int64_t read_binary_number (void) {
+  uint64_t res = 0;
+  int shift = 0, ch;
+  do {
+    if ((ch = getc (file)) == EOF)
+      die ("unexpected end-of-file in binary proof");
+    if (shift > 56)
+      die ("binary number too large");
+    res |= (uint64_t) (ch & 0x7f) << shift;
+    shift += 7;
+  } while (ch & 0x80);
+  return (int64_t) res;
+}
+
+static int64_t decode (int64_t x) { return (x & 1) ? -(x >> 1) : x >> 1; }
+
+static int read_char (void) {
+  int ch = getc (file);
+  if (ch == '\n')
+    lineno++;
+  return ch;
+}
+
+/* Parse a (possibly negative) textual number starting at '*ch', which is
+ * updated to the first character after it.  Returns zero at the end of
+ * the file and a negative value if there is no number.
+ */
+static int read_text_number (int64_t *res, int *ch) {
+  int sign = 1;
+  while (*ch == ' ' || *ch == '\n' || *ch == '\r' || *ch == '\t')
+    *ch = read_char ();
+  if (*ch == EOF)
+    return 0;
+  if (*ch == '-') {
+    sign = -1;
+    *ch = read_char ();
+  }
+  if (!isdigit (*ch))
+    return -1;
+  *res = 0;
+  while (isdigit (*ch)) {
+    *res = 10 * *res + (*ch - '0');
+    *ch = read_char ();
+  }
+  *res *= sign;
+  return 1;
+}
+
+static void text_numbers (Stack *s, int *ch) {
+  int64_t x;
+  for (;;) {
+    int r = read_text_number (&x, ch);
+    if (r <= 0)
+      die ("line %" PRId64 ": expected number", lineno);
+    if (!x)
+      break;
+    push (s, x);
+  }
+}
+
+static void delete_clause (int64_t id) {
+  if (id <= 0 || id >= size_clauses || !clauses[id])
+    die ("deleting non-existing clause %" PRId64, id);
+  free (clauses[id]);
+  clauses[id] = 0;
+  deleted++;
+}
+
+/* Check and add the parsed clause and return whether it is empty.
+ */
+static int handle_addition (int64_t id) {
+  const char *err = check ();
+  backtrack ();
+  if (err)
+    die ("clause %" PRId64 " failed: %s", id, err);
+  add_clause (id);
+  added++;
+  return lits.top == lits.start;
+}
+
+int main (int argc, char **argv) {
+  int64_t x, id, original = 0;
+  int ch, empty = 0;
+  FILE *dimacs;
+  if (argc != 3)
+    die ("usage: lratchk <dimacs> <lrat-proof>");
+  if (!(dimacs = fopen (argv[1], "r")))
+    die ("can not read '%s'", argv[1]);
+  file = dimacs;
+  ch = read_char ();
+  while (ch == 'c' || ch == 'p') {
+    while ((ch = read_char ()) != '\n' && ch != EOF)
+      ;
+    ch = read_char ();
+  }
+  for (;;) {
+    int r = read_text_number (&x, &ch);
+    if (!r)
+      break;
+    if (r < 0)
+      die ("invalid DIMACS file '%s'", argv[1]);
+    if (x)
+      push (&lits, x);
+    else
+      add_clause (++original), lits.top = lits.start;
+  }
+  fclose (dimacs);
+  msg ("parsed %" PRId64 " original clauses in '%s'", original, argv[1]);
+  if (!(file = fopen (argv[2], "r")))
+    die ("can not read '%s'", argv[2]);
+  lineno = 1;
+  ch = getc (file);
+  binary = (ch == 'a' || ch == 'd');
+  msg ("reading %s LRAT proof '%s'", binary ? "binary" : "textual",
+       argv[2]);
+  while (!empty && ch != EOF) {
+    lits.top = lits.start;
+    hints.top = hints.start;
+    if (binary) {
+      if (ch == 'a') {
+        id = read_binary_number ();
+        while ((x = read_binary_number ()))
+          push (&lits, decode (x));
+        while ((x = read_binary_number ()))
+          push (&hints, decode (x));
+        empty = handle_addition (id);
+      } else if (ch == 'd') {
+        while ((x = read_binary_number ()))
+          delete_clause (decode (x));
+      } else
+        die ("invalid binary proof step '%c'", ch);
+      ch = getc (file);
+    } else {
+      int r = read_text_number (&id, &ch);
+      if (!r)
+        break;
+      if (r < 0)
+        die ("line %" PRId64 ": expected clause identifier", lineno);
+      while (ch == ' ')
+        ch = read_char ();
+      if (ch == 'd') {
+        ch = read_char ();
+        text_numbers (&hints, &ch);
+        for (int64_t *p = hints.start; p != hints.top; p++)
+          delete_clause (*p);
+      } else {
+        text_numbers (&lits, &ch);
+        text_numbers (&hints, &ch);
+        empty = handle_addition (id);
+      }
+    }
+  }
+  fclose (file);
+  msg ("checked %" PRId64 " added and %" PRId64 " deleted clauses", added,
+       deleted);
+  if (!empty)
+    die ("empty clause not derived");
+  msg ("empty clause derived");
+  fputs ("s VERIFIED\n", stdout);
+  return 0;
+}
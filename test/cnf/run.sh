@@ -44,6 +44,7 @@ coresolver="$CADICALBUILD/cadical"
 simpsolver="$CADICALBUILD/../scripts/run-simplifier-and-extend-solution.sh"
 proofchecker=$CADICALBUILD/drat-trim
 solutionchecker=$CADICALBUILD/precochk
+lratchecker=$CADICALBUILD/lratchk
 makefile=$CADICALBUILD/makefile
 
 if [ ! -f $proofchecker -o ! -f $solutionchecker ]
@@ -80,33 +81,55 @@ else
   msg "external proof checking with '$proofchecker'"
 fi
 
+if [ ! -f $lratchecker -o ../test/cnf/lratchk.c -nt $lratchecker ]
+then
+  cmd="cc -O -o $lratchecker ../test/cnf/lratchk.c"
+  if $cmd 2>/dev/null
+  then
+    msg "external LRAT proof checking with '$lratchecker'"
+  else
+    msg "no external LRAT proof checking " \
+        "(compiling '../test/cnf/lratchk.c' failed)"
+    lratchecker=none
+  fi
+else
+  msg "external LRAT proof checking with '$lratchecker'"
+fi
+
 
 #--------------------------------------------------------------------------#
 
 ok=0
 failed=0
 
+coreopts=""
+coremode=core
+
 core () {
-  msg "running CNF test core ${HILITE}'$1'${NORMAL}"
-  prefix=$CADICALBUILD/test-cnf-core
+  msg "running CNF test $coremode ${HILITE}'$1'${NORMAL}"
+  prefix=$CADICALBUILD/test-cnf-$coremode
   cnf=../test/cnf/$1.cnf
   prf=$prefix-$1.prf
   log=$prefix-$1.log
   err=$prefix-$1.err
   chk=$prefix-$1.chk
+  case "$coreopts" in
+    *--lrat*) checker=$lratchecker;;
+    *) checker=$proofchecker;;
+  esac
   if [ -f cnf/$1.sol ]
   then
     solopts=" -r ../test/cnf/$1.sol"
   else
     solopts=""
   fi
-  if [ ! $2 = 20 -o x"$proofchecker" = xnone ]
+  if [ ! $2 = 20 -o x"$checker" = xnone ]
   then
     proofopts=""
   else
     proofopts=" $prf"
   fi
-  opts="$cnf --check$solopts$proofopts"
+  opts="$cnf --check$solopts$proofopts$coreopts"
   cecho "$coresolver \\"
   cecho "$opts"
   cecho -n "# $2 ..."
@@ -143,17 +166,17 @@ core () {
   elif [ $res = 20 ]
   then
     cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
-    if [ ! x"$proofchecker" = xnone ]
+    if [ ! x"$checker" = xnone ]
     then
-      cecho "$proofchecker \\"
+      cecho "$checker \\"
       cecho "$cnf $prf"
       cecho -n "# 0 ..."
-      if $proofchecker $cnf $prf 1>&2 >$chk
+      if $checker $cnf $prf 1>&2 >$chk
       then
 	cecho " ${GOOD}ok${NORMAL} (proof checked)"
 	ok=`expr $ok + 1`
       else
-	cecho " ${BAD}FAILED${NORMAL} (proof check '$proofchecker $cnf $prf' failed)"
+	cecho " ${BAD}FAILED${NORMAL} (proof check '$checker $cnf $prf' failed)"
 	failed=`expr $failed + 1`
       fi
     fi
@@ -207,6 +230,235 @@ run () {
   simp $*
 }
 
+# Write a textual proof to '<stdout>' interleaved with the messages of the
+# solver, make sure that no message ended up in the middle of a proof line
+# and check the proof after removing all message lines.  The proof of
+# 'ph8' is larger than the smallest proof buffer of one MB.
+
+stdout () {
+  msg "running CNF test stdout ${HILITE}'$1'${NORMAL}"
+  prefix=$CADICALBUILD/test-cnf-stdout
+  cnf=../test/cnf/$1.cnf
+  prf=$prefix-$1.prf
+  log=$prefix-$1.log
+  err=$prefix-$1.err
+  chk=$prefix-$1.chk
+  opts="$cnf - --no-binary --proofbuffer=1 -v"
+  cecho "$coresolver \\"
+  cecho "$opts"
+  cecho -n "# $2 ..."
+  "$coresolver" $opts 1>$log 2>$err
+  res=$?
+  if [ ! $res = $2 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+  else
+    grep -v '^[csv]\( \|$\)' $log > $prf
+    mixed=`grep -c '[^-0-9 d]' $prf`
+    if [ ! $mixed = 0 ]
+    then
+      cecho " ${BAD}FAILED${NORMAL} ($mixed proof lines mixed with messages)"
+      failed=`expr $failed + 1`
+      return
+    fi
+    cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+    if [ x"$proofchecker" = xnone ]
+    then
+      ok=`expr $ok + 1`
+      return
+    fi
+    cecho "$proofchecker \\"
+    cecho "$cnf $prf"
+    cecho -n "# 0 ..."
+    if $proofchecker $cnf $prf 1>&2 >$chk
+    then
+      cecho " ${GOOD}ok${NORMAL} (proof on '<stdout>' checked)"
+      ok=`expr $ok + 1`
+    else
+      cecho " ${BAD}FAILED${NORMAL} (proof check '$proofchecker $cnf $prf' failed)"
+      failed=`expr $failed + 1`
+    fi
+  fi
+}
+
+# Solve the same formula quietly and verbosely with binary clauses kept
+# outside of the arena.  Printing messages changes where clauses outside
+# of the arena are allocated, but must not change the search.  Thus both
+# runs have to produce exactly the same LRAT proof.  Further options can
+# be given as third argument.
+
+verbosity () {
+  msg "running CNF test verbosity ${HILITE}'$1'${NORMAL}"
+  prefix=$CADICALBUILD/test-cnf-verbosity
+  cnf=../test/cnf/$1.cnf
+  log=$prefix-$1.log
+  err=$prefix-$1.err
+  for mode in q v
+  do
+    prf=$prefix-$1-$mode.prf
+    opts="$cnf -$mode --lrat --no-binary $prf $3"
+    cecho "$coresolver \\"
+    cecho "$opts"
+    cecho -n "# $2 ..."
+    "$coresolver" $opts 1>$log 2>$err
+    res=$?
+    if [ ! $res = $2 ]
+    then
+      cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+      failed=`expr $failed + 1`
+      return
+    fi
+    cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+  done
+  cecho "cmp \\"
+  cecho "$prefix-$1-q.prf $prefix-$1-v.prf"
+  cecho -n "# 0 ..."
+  if cmp $prefix-$1-q.prf $prefix-$1-v.prf 1>&2 >/dev/null
+  then
+    cecho " ${GOOD}ok${NORMAL} (identical proofs)"
+    ok=`expr $ok + 1`
+  else
+    cecho " ${BAD}FAILED${NORMAL} (proofs differ)"
+    failed=`expr $failed + 1`
+  fi
+}
+
+# Read a formula compressed with the external tool (second argument) and
+# write the proof and the formula compressed again (by '--zlib' and
+# '--lzma' in-process, otherwise through the same tool).  Then check the
+# decompressed proof and solve the written formula again.
+
+compressed () {
+  msg "running CNF test compressed ${HILITE}'$3.cnf.$1'${NORMAL}"
+  if ! $2 --version 1>/dev/null 2>/dev/null
+  then
+    msg "skipping CNF test compressed '$3.cnf.$1' ('$2' not found)"
+    return
+  fi
+  prefix=$CADICALBUILD/test-cnf-compressed-$1
+  cnf=../test/cnf/$3.cnf
+  input=$prefix-$3.cnf.$1
+  output=$prefix-$3-output.cnf.$1
+  prf=$prefix-$3.prf
+  log=$prefix-$3.log
+  err=$prefix-$3.err
+  chk=$prefix-$3.chk
+  $2 -c $cnf > $input
+  rm -f $output $prf.$1
+  opts="$input --check -o $output"
+  [ $4 = 20 ] && opts="$opts $prf.$1"
+  cecho "$coresolver \\"
+  cecho "$opts"
+  cecho -n "# $4 ..."
+  "$coresolver" $opts 1>$log 2>$err
+  res=$?
+  if [ ! $res = $4 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+    return
+  fi
+  cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+  cecho "$coresolver \\"
+  cecho "$output"
+  cecho -n "# $4 ..."
+  "$coresolver" $output 1>$log 2>$err
+  res=$?
+  if [ ! $res = $4 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (written formula gives exit code $res)"
+    failed=`expr $failed + 1`
+    return
+  fi
+  cecho " ${GOOD}ok${NORMAL} (written formula read back)"
+  if [ ! $4 = 20 -o x"$proofchecker" = xnone ]
+  then
+    ok=`expr $ok + 1`
+    return
+  fi
+  $2 -d -c $prf.$1 > $prf
+  cecho "$proofchecker \\"
+  cecho "$cnf $prf"
+  cecho -n "# 0 ..."
+  if $proofchecker $cnf $prf 1>&2 >$chk
+  then
+    cecho " ${GOOD}ok${NORMAL} (decompressed proof checked)"
+    ok=`expr $ok + 1`
+  else
+    cecho " ${BAD}FAILED${NORMAL} (proof check '$proofchecker $cnf $prf' failed)"
+    failed=`expr $failed + 1`
+  fi
+}
+
+# Write a trimmed LRAT proof in binary and in textual format and check it
+# with the simple LRAT checker 'lratchk'.  The internal checker is enabled
+# too, but it only checks the derivations before trimming.
+
+lrattrim () {
+  for mode in binary text
+  do
+    msg "running CNF test lrattrim $mode ${HILITE}'$1'${NORMAL}"
+    prefix=$CADICALBUILD/test-cnf-lrattrim-$mode
+    cnf=../test/cnf/$1.cnf
+    prf=$prefix-$1.prf
+    log=$prefix-$1.log
+    err=$prefix-$1.err
+    chk=$prefix-$1.chk
+    opts="$cnf --check --lrat --lrattrim $prf"
+    [ $mode = text ] && opts="$opts --no-binary"
+    cecho "$coresolver \\"
+    cecho "$opts"
+    cecho -n "# $2 ..."
+    "$coresolver" $opts 1>$log 2>$err
+    res=$?
+    if [ ! $res = $2 ]
+    then
+      cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+      failed=`expr $failed + 1`
+      continue
+    fi
+    cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+    if [ x"$lratchecker" = xnone ]
+    then
+      ok=`expr $ok + 1`
+      continue
+    fi
+    cecho "$lratchecker \\"
+    cecho "$cnf $prf"
+    cecho -n "# 0 ..."
+    if $lratchecker $cnf $prf 1>$chk 2>&1
+    then
+      cecho " ${GOOD}ok${NORMAL} (trimmed LRAT proof checked)"
+      ok=`expr $ok + 1`
+    else
+      cecho " ${BAD}FAILED${NORMAL} (proof check '$lratchecker $cnf $prf' failed)"
+      failed=`expr $failed + 1`
+    fi
+  done
+}
+
+# Run 'core' with additional options under the given test mode name.
+
+with () {
+  coremode=$1
+  coreopts=" $2"
+  core $3 $4
+  coreopts=""
+  coremode=core
+}
+
+# Parse through the memory mapped path with many small chunks scanned
+# concurrently (the default chunk size exceeds all files in here).
+
+mapped () {
+  coreopts=" --parsechunk=1 --parsejobs=4"
+  coremode=mapped
+  core $*
+  coreopts=""
+  coremode=core
+}
+
 run empty 10
 run false 20
 
@@ -304,6 +556,96 @@ run add128 20
 
 run prime65537 20
 
+stdout ph6 20
+stdout ph8 20
+
+verbosity ph8 20
+
+# Solving 'add128' includes minor collections, which leave clauses in two
+# separately allocated spaces of the arena.
+
+verbosity add128 20
+
+mapped add128 20
+mapped prime65537 20
+mapped sqrt1042441 10
+
+lrattrim ph6 20
+lrattrim add32 20
+lrattrim prime65537 20
+
+compressed gz gzip ph6 20
+compressed gz gzip prime2209 10
+compressed xz xz ph6 20
+compressed xz xz prime2209 10
+
+# The internal LRAT checker can check the proof in a separate thread.  It
+# only gets proof chains with '--lrat' and then 'core' checks the written
+# LRAT proof with 'lratchk' instead of 'drat-trim'.
+
+with checkproofthread "--lrat --checkproofthread" ph6 20
+with checkproofthread "--lrat --checkproofthread" add64 20
+with checkproofthread "--lrat --checkproofthread" prime65537 20
+with checkproofthread "--lrat --checkproofthread" sqrt10201 10
+
+# Force early rephasing, which then walks with the simpler local search
+# without cached break values.
+
+with walkcounts "--rephaseint=10 --walkcounts=0" prime2209 10
+with walkcounts "--rephaseint=10 --walkcounts=0" ph6 20
+with walkcounts "--rephaseint=10 --walkcounts=0" add64 20
+
+# Helper walkers run in parallel threads but must not make the search
+# depend on thread scheduling.
+
+with walkjobs "--rephaseint=10 --walkjobs=4" prime2209 10
+with walkjobs "--rephaseint=10 --walkjobs=4" ph6 20
+with walkjobs "--rephaseint=10 --walkjobs=4" add64 20
+verbosity add64 20 "--rephaseint=10 --walkjobs=4"
+
+# Bounded variable elimination in parallel batches, which for the smaller
+# formulas needs an earlier first elimination round.
+
+with elimpar "--elimpar=1 --elimparjobs=2" add128 20
+with elimpar "--elimpar=1 --elimparjobs=2 --elimint=10" add64 20
+with elimpar "--elimpar=1 --elimparjobs=2 --elimint=10" prime2209 10
+verbosity add128 20 "--elimpar=1 --elimparjobs=2"
+
+# Arena spaces mapped for huge pages, where the test formulas are too small
+# to reach the default minimum space size.
+
+with arenahuge "--arenahuge=1" add128 20
+with arenahuge "--arenahuge=1 --arenahugemin=0" add128 20
+with arenahuge "--arenahuge=1 --arenahugemin=0" prime65537 20
+with arenahuge "--arenahuge=1 --arenahugemin=0" sqrt10201 10
+verbosity add128 20 "--arenahuge=1 --arenahugemin=0"
+
+# Replacement watch search skipping false literals with the AVX2 kernel (if
+# supported), which has to follow exactly the same search as without.
+
+with simd "--simd=1" add128 20
+with simd "--simd=1" prime65537 20
+with simd "--simd=1" sqrt10201 10
+with simd "--simd=1 --lrat" ph8 20
+verbosity add128 20 "--simd=1"
+
+# Vivification candidates checked in parallel before vivifying them, where
+# subsumption rounds (and thus vivification) have to start early.
+
+with vivifypar "--vivifypar=1 --vivifyparjobs=2 --subsumeint=10" ph6 20
+with vivifypar "--vivifypar=1 --vivifyparjobs=2 --subsumeint=10" add64 20
+with vivifypar "--vivifypar=1 --vivifyparjobs=2 --subsumeint=10" prime65537 20
+verbosity add64 20 "--vivifypar=1 --vivifyparjobs=2 --subsumeint=10"
+
+# Cube-and-conquer generates cubes with lookahead, which scores probes
+# sequentially or in parallel on a clause snapshot.  With proofs it falls
+# back to plain solving, thus only satisfiable formulas are used.
+
+with lookaheadseq "--conquer 4 --lookaheadpar=0" sqrt10201 10
+with lookaheadpar "--conquer 4 --lookaheadjobs=4" sqrt10201 10
+with lookaheadseq "--conquer 3 --lookaheadpar=0" prime2209 10
+with lookaheadpar "--conquer 3 --lookaheadjobs=4" prime2209 10
+
 #--------------------------------------------------------------------------#
 
 [ $ok -gt 0 ] && OK="$GOOD"